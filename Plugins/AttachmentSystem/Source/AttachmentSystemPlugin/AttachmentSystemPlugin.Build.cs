@@ -13,6 +13,7 @@ public class AttachmentSystemPlugin : ModuleRules
 			new string[]
 			{
 				"Core",
+				"TraceLog",
 				"RingBufferPlugin"
 			}
 			);
@@ -23,9 +24,18 @@ public class AttachmentSystemPlugin : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
+				"MeshDescription",
+				"StaticMeshDescription",
 				"Slate",
 				"SlateCore"
 			}
 			);
+
+		if (Target.bBuildEditor)
+		{
+			// FEditorDelegates (build plan cache invalidation on PIE end)
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }
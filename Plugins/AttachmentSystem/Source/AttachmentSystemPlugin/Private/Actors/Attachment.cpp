@@ -1,5 +1,25 @@
 #include "Actors/Attachment.h"
 
+#include "Actors/Weapon.h"
+#include "Components/AttachmentBehaviorComponent.h"
+#include "Components/WeaponBuilderComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AttachmentSystemTrace.h"
+#include "Subsystems/AttachmentDefinitionStore.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Load Attachment Info"), STAT_LoadAttachmentInfo,
+                   STATGROUP_AttachmentSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ammo Ops Recorded"), STAT_AmmoOpsRecorded,
+                               STATGROUP_AttachmentSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ammo Op RPCs"), STAT_AmmoOpRpcs,
+                               STATGROUP_AttachmentSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ammo Ops Rejected"), STAT_AmmoOpsRejected,
+                               STATGROUP_AttachmentSystem);
+
 void AAttachment::PostInitializeComponents() {
   Super::PostInitializeComponents();
 
@@ -8,7 +28,8 @@ void AAttachment::PostInitializeComponents() {
 }
 
 AAttachment::AAttachment() {
-  PrimaryActorTick.bCanEverTick = true;
+  // Opt in through UAttachmentTickSubsystem instead
+  PrimaryActorTick.bCanEverTick = false;
 
   // Create skeletal mesh component for the attachment
   MeshComponent = CreateDefaultSubobject<USkeletalMeshComponent>(
@@ -18,43 +39,95 @@ AAttachment::AAttachment() {
   SetRootComponent(MeshComponent);
 }
 
+bool AAttachment::RequiresActor() const {
+  // The behaviour component lives on the actor
+  return bKeepActorInCompactBuild || BehaviorClass.Get() != nullptr;
+}
+
 void AAttachment::BeginPlay() {
   Super::BeginPlay();
   // Runtime initialization or event bindings go here
 }
 
-void AAttachment::Tick(const float DeltaTime) {
-  Super::Tick(DeltaTime);
-  // Per-frame logic (not needed for static attachments)
+void AAttachment::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  // Still attached here; the weapon must drop this part from its bake
+  if (EndPlayReason == EEndPlayReason::Destroyed) {
+    RequestWeaponRebake();
+  }
+  Super::EndPlay(EndPlayReason);
+}
+
+void AAttachment::OnRep_AttachmentReplication() {
+  Super::OnRep_AttachmentReplication();
+  RequestWeaponRebake();
+}
+
+void AAttachment::OnRep_Owner() {
+  Super::OnRep_Owner();
+  RequestWeaponRebake();
+}
+
+void AAttachment::RequestWeaponRebake() {
+  if (HasAuthority())
+    return;
+
+  AWeapon *OwningWeapon = Cast<AWeapon>(GetOwner());
+  if (AWeapon *Previous = BakedIntoWeapon.Get();
+      Previous && Previous != OwningWeapon) {
+    if (UWeaponBuilderComponent *Builder = Previous->GetWeaponBuilder()) {
+      Builder->RequestRebake();
+    }
+  }
+
+  BakedIntoWeapon = OwningWeapon;
+  if (OwningWeapon) {
+    if (UWeaponBuilderComponent *Builder = OwningWeapon->GetWeaponBuilder()) {
+      Builder->RequestRebake();
+    }
+  }
 }
 
 void AAttachment::LoadAttachmentInfo() {
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_LoadAttachmentInfo);
+
   // Validate DataTable reference
   if (!IsValid(AttachmentDataTable)) {
-    UE_LOG(LogTemp, Warning,
+    UE_LOG(LogAttachmentSystem, Warning,
            TEXT("AttachmentDataTable is invalid for Attachment %s"),
            *GetName());
     return;
   }
 
-  const FString ContextString(TEXT("Finding Row in Attachments Data Table"));
+  // Try to fetch the shared row by ID
+  if (UAttachmentDefinitionStore *Store =
+          GEngine ? GEngine->GetEngineSubsystem<UAttachmentDefinitionStore>()
+                  : nullptr) {
+    AttachmentDefinition = Store->FindDefinition(AttachmentDataTable, ID);
+  } else if (const FAttachmentInfo *FoundRow =
+                 AttachmentDataTable->FindRow<FAttachmentInfo>(
+                     ID, TEXT("Finding Row in Attachments Data Table"))) {
+    AttachmentDefinition = MakeShared<const FAttachmentInfo>(*FoundRow);
+  }
 
-  // Try to fetch row by ID
-  const FAttachmentInfo *FoundRow =
-      AttachmentDataTable->FindRow<FAttachmentInfo>(ID, ContextString);
-  if (!FoundRow) {
-    UE_LOG(LogTemp, Warning, TEXT("Attachment ID '%s' not found in DataTable!"),
-           *ID.ToString());
+  if (!AttachmentDefinition.IsValid()) {
+    // GetAttachmentInfo keeps serving the instance's AttachmentInfo
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Attachment ID '%s' not found in DataTable!"), *ID.ToString());
     return;
   }
 
-  // Store DataTable row into local struct
-  AttachmentInfo = *FoundRow;
-  UE_LOG(LogTemp, Log, TEXT("Attachment '%s' built successfully."),
-         *ID.ToString());
+  const FAttachmentInfo &AttachmentInfo = *AttachmentDefinition;
+  UE_LOG(LogAttachmentSystem, Verbose,
+         TEXT("Attachment '%s' built successfully."), *ID.ToString());
 
-  // Apply mesh from DataTable definition
-  MeshComponent->SetSkeletalMeshAsset(AttachmentInfo.Mesh.LoadSynchronous());
+  // Apply mesh from DataTable definition. The builder streams meshes in
+  // before spawning, so this only falls back to a blocking load when the
+  // attachment is spawned outside of BuildWeapon.
+  USkeletalMesh *Mesh = AttachmentInfo.Mesh.Get();
+  if (!Mesh && !AttachmentInfo.Mesh.IsNull()) {
+    Mesh = AttachmentInfo.Mesh.LoadSynchronous();
+  }
+  MeshComponent->SetSkeletalMeshAsset(Mesh);
 
   // Configure collision to allow overlap detection
   if (MeshComponent) {
@@ -70,6 +143,224 @@ void AAttachment::LoadAttachmentInfo() {
         ECC_WorldDynamic, ECR_Overlap); // Only overlap with other attachments
   }
 
+  ApplyStaticFallback(AttachmentInfo);
+
   // Initialize runtime durability with static value from DataTable
-  AttachmentCurrentState.Durability = AttachmentInfo.Durability;
-}
\ No newline at end of file
+  SetDurability(AttachmentInfo.Durability);
+}
+
+bool AAttachment::HasAnimatedBones(const USkeletalMesh *Mesh) {
+  if (!Mesh)
+    return false;
+  return Mesh->GetRefSkeleton().GetRawBoneNum() > 1 ||
+         Mesh->GetMorphTargets().Num() > 0;
+}
+
+bool AAttachment::IsRenderedAsStatic() const {
+  return StaticMeshComponent && StaticMeshComponent->GetStaticMesh() &&
+         StaticMeshComponent->IsVisible();
+}
+
+void AAttachment::ApplyStaticFallback(const FAttachmentInfo &AttachmentInfo) {
+  if (!MeshComponent)
+    return;
+
+  UStaticMesh *Static = AttachmentInfo.StaticMesh.Get();
+  if (!Static && !AttachmentInfo.StaticMesh.IsNull()) {
+    Static = AttachmentInfo.StaticMesh.LoadSynchronous();
+  }
+
+  const bool bUseStatic =
+      Static && !HasAnimatedBones(MeshComponent->GetSkeletalMeshAsset());
+
+  if (bUseStatic && !StaticMeshComponent) {
+    StaticMeshComponent = NewObject<UStaticMeshComponent>(
+        this, FName{TEXTVIEW("StaticMeshComponent")});
+    StaticMeshComponent->SetupAttachment(MeshComponent);
+    StaticMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    StaticMeshComponent->RegisterComponent();
+  }
+
+  if (StaticMeshComponent) {
+    StaticMeshComponent->SetStaticMesh(bUseStatic ? Static : nullptr);
+    StaticMeshComponent->SetVisibility(bUseStatic);
+  }
+
+  // The skeletal component keeps sockets and overlap queries, but is
+  // neither drawn nor skinned while the static mesh stands in for it
+  MeshComponent->SetVisibility(!bUseStatic);
+  MeshComponent->bNoSkeletonUpdate = bUseStatic;
+}
+
+void AAttachment::SetDurability(const float NewDurability) {
+  const float OldDurability = AttachmentCurrentState.Durability;
+  if (OldDurability == NewDurability)
+    return;
+
+  AttachmentCurrentState.Durability = NewDurability;
+  OnDurabilityChanged.Broadcast(this, OldDurability, NewDurability);
+}
+
+void AAttachment::ResetForPool() {
+  DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+  // Mesh is re-applied from the DataTable on the next LoadAttachmentInfo
+  if (MeshComponent) {
+    MeshComponent->SetSkeletalMeshAsset(nullptr);
+    MeshComponent->SetVisibility(true);
+    MeshComponent->bNoSkeletonUpdate = false;
+  }
+  if (StaticMeshComponent) {
+    StaticMeshComponent->SetStaticMesh(nullptr);
+    StaticMeshComponent->SetVisibility(false);
+  }
+
+  // Child instances belong to the weapon that used this attachment
+  for (FAttachmentLink &Link : ChildrenLinks) {
+    Link.ChildInstances.Reset();
+  }
+
+  // The next owner binds its own listeners. The weapon has already let go
+  // (ClearWeapon broadcasts OnWeaponCleared), so the durability
+  // reset below has nobody left to notify.
+  OnDurabilityChanged.Clear();
+
+  PendingAmmoOps.Reset();
+  if (const UWorld *World = GetWorld()) {
+    World->GetTimerManager().ClearTimer(AmmoOpFlushHandle);
+  }
+
+  StartPosition = 0;
+  AttachmentCurrentState = FAttachmentCurrentState();
+}
+
+void AAttachment::QueueAmmoOp(const EAmmoOpType Op,
+                              const EBulletType BulletType,
+                              const int32 Count) {
+  PendingAmmoOps.Record(Op, BulletType, Count);
+  INC_DWORD_STAT(STAT_AmmoOpsRecorded);
+
+  // One flush per frame/interval, however many ops are recorded before it
+  FTimerManager &TimerManager = GetWorldTimerManager();
+  if (TimerManager.IsTimerActive(AmmoOpFlushHandle) ||
+      TimerManager.IsTimerPending(AmmoOpFlushHandle))
+    return;
+
+  if (AmmoOpFlushInterval > 0.f) {
+    TimerManager.SetTimer(AmmoOpFlushHandle, this, &AAttachment::FlushAmmoOps,
+                          AmmoOpFlushInterval, false);
+  } else {
+    AmmoOpFlushHandle =
+        TimerManager.SetTimerForNextTick(this, &AAttachment::FlushAmmoOps);
+  }
+}
+
+void AAttachment::FlushAmmoOps() {
+  GetWorldTimerManager().ClearTimer(AmmoOpFlushHandle);
+
+  while (!PendingAmmoOps.IsEmpty()) {
+    TArray<FAmmoOp> Ops;
+    PendingAmmoOps.Flush(Ops);
+    Server_ApplyAmmoOps(Ops);
+    ++NumAmmoOpRpcsSent;
+    INC_DWORD_STAT(STAT_AmmoOpRpcs);
+  }
+}
+
+void AAttachment::Server_ApplyAmmoOps_Implementation(
+    const TArray<FAmmoOp> &Ops) {
+  if (!HasAuthority())
+    return;
+
+  if (Ops.Num() > FAmmoOp::MaxOpsPerFlush) {
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("%s rejected %d ammo ops (max %d per flush)"), *GetName(),
+           Ops.Num(), FAmmoOp::MaxOpsPerFlush);
+    INC_DWORD_STAT_BY(STAT_AmmoOpsRejected, Ops.Num());
+    return;
+  }
+
+  // In order; later ops may depend on earlier ones, so stop at the first
+  // one that is malformed or not meant for this attachment
+  for (int32 i = 0; i < Ops.Num(); ++i) {
+    if (!Ops[i].IsValid() || !ApplyAmmoOp(Ops[i])) {
+      UE_LOG(LogAttachmentSystem, Warning,
+             TEXT("%s rejected ammo op %d (op=%d, count=%d), dropping %d"),
+             *GetName(), i, static_cast<int32>(Ops[i].Op), Ops[i].Count,
+             Ops.Num() - i);
+      INC_DWORD_STAT_BY(STAT_AmmoOpsRejected, Ops.Num() - i);
+      return;
+    }
+  }
+}
+
+void AAttachment::RunDefinitionSharingTest() {
+  constexpr int32 TestCount = 100'000;
+
+  if (!AttachmentDefinition.IsValid()) {
+    LoadAttachmentInfo();
+  }
+  if (!AttachmentDefinition.IsValid()) {
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Definition Sharing Test: no definition for '%s'"),
+           *ID.ToString());
+    return;
+  }
+
+  const FAttachmentInfo &Definition = *AttachmentDefinition;
+
+  // Inline size plus what each copy allocates on its own. FText copies
+  // share one ref-counted payload and the soft mesh paths are names (asset
+  // paths have no sub-path), so only the modifier array is duplicated.
+  const SIZE_T CopiedBytes =
+      sizeof(FAttachmentInfo) + Definition.Modifiers.GetAllocatedSize();
+  const SIZE_T SharedBytes = sizeof(AttachmentDefinition);
+
+  UE_LOG(LogAttachmentSystem, Warning,
+         TEXT("Definition Sharing Test: '%s', %d instances"), *ID.ToString(),
+         TestCount);
+  UE_LOG(LogAttachmentSystem, Warning,
+         TEXT("Per instance → copied row %llu bytes | shared %llu bytes"),
+         static_cast<uint64>(CopiedBytes), static_cast<uint64>(SharedBytes));
+
+  int32 Checksum = 0;
+
+  {
+    TArray<FAttachmentInfo> Copies;
+    Copies.Reserve(TestCount);
+
+    const double Start = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < TestCount; i++) {
+      Copies.Add(Definition);
+      Checksum += Copies.Last().Modifiers.Num();
+    }
+
+    const double End = FPlatformTime::Seconds();
+    const double DurationMs = (End - Start) * 1000.0;
+
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Copied rows → %.3f ms (%d row copies)"), DurationMs,
+           TestCount);
+  }
+
+  {
+    TArray<TSharedPtr<const FAttachmentInfo>> Shared;
+    Shared.Reserve(TestCount);
+
+    const double Start = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < TestCount; i++) {
+      Shared.Add(AttachmentDefinition);
+      Checksum += Shared.Last()->Modifiers.Num();
+    }
+
+    const double End = FPlatformTime::Seconds();
+    const double DurationMs = (End - Start) * 1000.0;
+
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Shared definition → %.3f ms (0 row copies)"), DurationMs);
+  }
+
+  UE_LOG(LogAttachmentSystem, Verbose, TEXT("Checksum: %d"), Checksum);
+}
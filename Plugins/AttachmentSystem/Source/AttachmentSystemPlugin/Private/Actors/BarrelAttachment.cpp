@@ -1,52 +1,69 @@
 ﻿#include "Actors/BarrelAttachment.h"
+#include "Misc/AttachmentSystemTrace.h"
 #include "Net/UnrealNetwork.h"
 
 ABarrelAttachment::ABarrelAttachment() {
   PrimaryActorTick.bCanEverTick = false;
   bReplicates = true;
-  UE_LOG(LogTemp, Warning, TEXT("ABarrelAttachment initialized"));
 }
 
 void ABarrelAttachment::SetChamberedRounds(const TArray<EBulletType>& NewRounds) {
   if (!HasAuthority()) {
-    Server_SetChamberedRounds(NewRounds);
+    // Clear + one op per run of identical rounds
+    QueueAmmoOp(EAmmoOpType::ClearChamber);
+    for (const EBulletType Round : NewRounds) {
+      QueueAmmoOp(EAmmoOpType::ChamberRounds, Round);
+    }
     return;
   }
 
   if (NewRounds.Num() > 0) {
-    ChamberedRounds = NewRounds;
-    UE_LOG(LogTemp, Warning, TEXT("SetChamberedRounds: %d rounds chambered"), NewRounds.Num());
+    ChamberedRounds.Reset();
+    ChamberedRounds.Append(NewRounds);
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::ChamberRounds, NewRounds[0],
+                          NewRounds.Num(), ChamberedRounds.Num());
+    UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("%s chambered %d rounds"), *GetName(), NewRounds.Num());
   } else {
-    ChamberedRounds.Empty();
-    UE_LOG(LogTemp, Warning, TEXT("SetChamberedRounds: chamber cleared"));
+    ChamberedRounds.Reset();
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::ClearChamber, EBulletType::None, 0, 0);
+    UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("%s chamber cleared"), *GetName());
   }
 }
 
-void ABarrelAttachment::Server_SetChamberedRounds_Implementation(const TArray<EBulletType>& NewRounds) {
-  if (!HasAuthority()) return;
-  SetChamberedRounds(NewRounds);
-}
-
 void ABarrelAttachment::ClearChamber() {
   if (!HasAuthority()) {
-    Server_ClearChamber();
+    QueueAmmoOp(EAmmoOpType::ClearChamber);
     return;
   }
 
-  ChamberedRounds.Empty();
-  UE_LOG(LogTemp, Warning, TEXT("ClearChamber called"));
+  ChamberedRounds.Reset();
+  TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::ClearChamber, EBulletType::None, 0, 0);
+  UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("%s chamber cleared"), *GetName());
+}
+
+bool ABarrelAttachment::ApplyAmmoOp(const FAmmoOp& Op) {
+  switch (Op.Op) {
+  case EAmmoOpType::ClearChamber:
+    ChamberedRounds.Reset();
+    return true;
+  case EAmmoOpType::ChamberRounds:
+    ChamberedRounds.PushBack(Op.BulletType, Op.Count);
+    return true;
+  default:
+    return false;
+  }
 }
 
-void ABarrelAttachment::Server_ClearChamber_Implementation() {
-  if (!HasAuthority()) return;
-  ClearChamber();
+void ABarrelAttachment::ResetForPool() {
+  Super::ResetForPool();
+  ChamberedRounds.Reset();
 }
 
 void ABarrelAttachment::OnRep_ChamberedRounds() {
   if (ChamberedRounds.Num() == 0) {
-    UE_LOG(LogTemp, Warning, TEXT("OnRep_ChamberedRounds: chamber is empty"));
+    UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("OnRep_ChamberedRounds: chamber is empty"));
   } else {
-    UE_LOG(LogTemp, Warning, TEXT("OnRep_ChamberedRounds: %d rounds replicated"), ChamberedRounds.Num());
+    UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("OnRep_ChamberedRounds: %d rounds replicated"), ChamberedRounds.Num());
   }
 }
 
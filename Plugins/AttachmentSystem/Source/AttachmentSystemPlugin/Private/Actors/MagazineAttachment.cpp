@@ -1,7 +1,9 @@
 ﻿#include "Actors/MagazineAttachment.h"
 #include "Engine/Engine.h"              // GEngine
+#include "Misc/AttachmentSystemTrace.h"
 #include "Misc/AttachmentSystemTypes.h" // for LogAttachmentSystem + enums
 #include "Net/UnrealNetwork.h"
+#include "Serialization/BitWriter.h"
 
 /* =============================
  * Lifecycle
@@ -15,10 +17,96 @@ void AMagazineAttachment::GetLifetimeReplicatedProps(
   Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
   DOREPLIFETIME(ThisClass, ReplicatedAmmoCount);
+  DOREPLIFETIME(ThisClass, ReplicatedContents);
 }
 
 void AMagazineAttachment::BeginPlay() { Super::BeginPlay(); }
 
+void AMagazineAttachment::LoadAttachmentInfo() {
+  Super::LoadAttachmentInfo();
+
+  const int32 RowCapacity = GetAttachmentInfo().MagazineCapacity;
+  ResizeStorage(RowCapacity > 0 ? RowCapacity
+                                : GetCapacityForType(MagazineType));
+}
+
+void AMagazineAttachment::ResizeStorage(const int32 NewCapacity) {
+  if (NewCapacity <= 0 || NewCapacity == MagazineCapacity)
+    return;
+
+  // Keep what is loaded (oldest first) up to the new capacity
+  TArray<EBulletType, TInlineAllocator<32>> Loaded;
+  EBulletType Round{};
+  while (BulletBuffer.Get(Round)) {
+    Loaded.Add(Round);
+  }
+
+  MagazineCapacity = NewCapacity;
+  BulletBuffer.Resize(MagazineCapacity);
+  const int32 Kept = FMath::Min(Loaded.Num(), MagazineCapacity);
+  BulletBuffer.Put(Loaded.GetData(), Kept);
+
+  // Rounds that no longer fit are dropped from the back: resend the rest
+  if (Kept < Loaded.Num()) {
+    ReplicatedContents.ConsumeAll();
+    ReplicatedContents.Load(MakeArrayView(Loaded.GetData(), Kept));
+  }
+
+  ReplicatedAmmoCount = GetAmmoCount();
+}
+
+FPackedRoundSequence AMagazineAttachment::ExportRounds() {
+  // SPSC ring has no peek: drain in one block, pack, put back in one block
+  TArray<EBulletType, TInlineAllocator<32>> Loaded;
+  Loaded.SetNumUninitialized(GetAmmoCount());
+  BulletBuffer.Get(Loaded.GetData(), Loaded.Num());
+  BulletBuffer.Put(Loaded.GetData(), Loaded.Num());
+
+  FPackedRoundSequence Packed;
+  Packed.Append(Loaded);
+  return Packed;
+}
+
+void AMagazineAttachment::ImportRounds(const FPackedRoundSequence &Rounds) {
+  if (!HasAuthority())
+    return;
+
+  EBulletType Discard{};
+  while (BulletBuffer.Get(Discard)) {
+  }
+
+  TArray<EBulletType> Unpacked = Rounds.ToArray();
+  const int32 Loaded = FMath::Min(Unpacked.Num(), MagazineCapacity);
+  BulletBuffer.Put(Unpacked.GetData(), Loaded);
+
+  ReplicatedContents.ConsumeAll();
+  ReplicatedContents.Load(MakeArrayView(Unpacked.GetData(), Loaded));
+  ReplicatedAmmoCount = GetAmmoCount();
+}
+
+int32 AMagazineAttachment::GetCapacityForType(const EMagazineType Type) {
+  switch (Type) {
+  case EMagazineType::Magpul_MOE_10:
+    return 10;
+  case EMagazineType::Magpul_MOE_20:
+  case EMagazineType::ProMag_Standard_20:
+    return 20;
+  case EMagazineType::Arsenal_Waffle_40:
+  case EMagazineType::ProMag_Standard_40:
+  case EMagazineType::Surplus_Steel_40_RPK:
+    return 40;
+  case EMagazineType::ProMag_Drum_50:
+    return 50;
+  case EMagazineType::ATI_Schmeisser_S60:
+    return 60;
+  case EMagazineType::KCI_Drum_75:
+  case EMagazineType::Chinese_Drum_75:
+    return 75;
+  default:
+    return 30;
+  }
+}
+
 void AMagazineAttachment::RunPerformanceTest() {
   constexpr int32 TestCount = 1'000'000;
   EBulletType Temp;
@@ -93,29 +181,123 @@ void AMagazineAttachment::RunPerformanceTest() {
            DurationMs);
   }
 
+  // Magazine-sized cycles: fixed 30-round buffer vs runtime-sized storage
+  {
+    constexpr int32 Capacity = 30;
+    constexpr int32 Cycles = TestCount / Capacity;
+    EBulletType Block[Capacity];
+
+    {
+      Lomont::RingBuffer<Capacity, EBulletType, int32> FixedBuffer;
+
+      const double Start = FPlatformTime::Seconds();
+
+      for (int32 c = 0; c < Cycles; c++) {
+        for (int32 i = 0; i < Capacity; i++) {
+          FixedBuffer.Put(EBulletType::Standard_FMJ);
+        }
+        FixedBuffer.Get(Block, Capacity);
+      }
+
+      const double End = FPlatformTime::Seconds();
+      const double DurationMs = (End - Start) * 1000.0;
+
+      UE_LOG(LogAttachmentSystem, Warning,
+             TEXT("Fixed RingBuffer<30> → %d fill/drain cycles in %.3f ms"),
+             Cycles, DurationMs);
+    }
+
+    {
+      Lomont::DynamicRingBuffer<EBulletType, uint32> RuntimeBuffer(Capacity);
+
+      const double Start = FPlatformTime::Seconds();
+
+      for (int32 c = 0; c < Cycles; c++) {
+        for (int32 i = 0; i < Capacity; i++) {
+          RuntimeBuffer.Put(EBulletType::Standard_FMJ);
+        }
+        RuntimeBuffer.Get(Block, Capacity);
+      }
+
+      const double End = FPlatformTime::Seconds();
+      const double DurationMs = (End - Start) * 1000.0;
+
+      UE_LOG(LogAttachmentSystem, Warning,
+             TEXT("DynamicRingBuffer(30) → %d fill/drain cycles in %.3f ms"),
+             Cycles, DurationMs);
+    }
+  }
+
   UE_LOG(LogAttachmentSystem, Warning, TEXT("Performance Test End"));
 }
 
+void AMagazineAttachment::RunReloadSpamTest() {
+  constexpr int32 ReloadRounds = 30;
+  constexpr int32 Reloads = 10;
+
+  // Straight FMJ, then FMJ with every fifth round a tracer
+  for (const int32 TracerEvery : {0, 5}) {
+    FAmmoOpBuffer Buffer;
+    int32 NumRpcs = 0;
+    int64 PayloadBits = 0;
+
+    for (int32 Reload = 0; Reload < Reloads; ++Reload) {
+      for (int32 i = 0; i < ReloadRounds; ++i) {
+        const bool bTracer = TracerEvery > 0 && (i + 1) % TracerEvery == 0;
+        Buffer.Record(EAmmoOpType::LoadRounds,
+                      bTracer ? EBulletType::Tracer
+                              : EBulletType::Standard_FMJ);
+      }
+
+      // One flush per reload, as the per-frame timer would do
+      while (!Buffer.IsEmpty()) {
+        TArray<FAmmoOp> Ops;
+        Buffer.Flush(Ops);
+
+        FBitWriter Writer(0, true);
+        for (FAmmoOp &Op : Ops) {
+          bool bSuccess = true;
+          Op.NetSerialize(Writer, nullptr, bSuccess);
+        }
+        PayloadBits += Writer.GetNumBits();
+        ++NumRpcs;
+      }
+    }
+
+    // Per-round RPCs carried one EBulletType byte each
+    const int32 LegacyRpcs = Reloads * ReloadRounds;
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Reload Spam (%s): per-round %d RPCs / %d bytes → coalesced "
+                "%d RPCs / %lld bytes (%d ops recorded)"),
+           TracerEvery > 0 ? TEXT("mixed") : TEXT("FMJ"), LegacyRpcs,
+           LegacyRpcs, NumRpcs, (PayloadBits + 7) / 8,
+           Buffer.GetNumRecorded());
+  }
+}
+
 /* =============================
  * Public API (Gameplay usage)
  * ============================= */
 
 bool AMagazineAttachment::AddBullet(EBulletType BulletType) {
   if (!HasAuthority()) {
-    Server_AddBullet(BulletType);
+    QueueAmmoOp(EAmmoOpType::LoadRounds, BulletType);
     return false;
   }
 
   if (GetAmmoCount() >= MagazineCapacity) {
-    UE_LOG(LogAttachmentSystem, Warning, TEXT("Magazine %s FULL! Capacity=%d"),
+    UE_LOG(LogAttachmentSystem, Verbose, TEXT("Magazine %s FULL! Capacity=%d"),
            *GetName(), MagazineCapacity);
     return false;
   }
 
   if (BulletBuffer.Put(BulletType)) {
-    UE_LOG(LogAttachmentSystem, Warning,
-           TEXT("Magazine %s added bullet: %s (AmmoCount=%d)"), *GetName(),
-           *BulletTypeToString(BulletType), GetAmmoCount());
+    ReplicatedContents.Load(BulletType);
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::LoadRounds, BulletType, 1,
+                          GetAmmoCount());
+    UE_LOG(LogAttachmentSystem, VeryVerbose,
+           TEXT("Magazine %s added bullet %d (AmmoCount=%d)"), *GetName(),
+           static_cast<int32>(BulletType), GetAmmoCount());
     // Update replicate if using
     ReplicatedAmmoCount = GetAmmoCount();
     return true;
@@ -123,39 +305,29 @@ bool AMagazineAttachment::AddBullet(EBulletType BulletType) {
   return false;
 }
 
-void AMagazineAttachment::Server_AddBullet_Implementation(
-    EBulletType BulletType) {
-  if (!HasAuthority())
-    return;
-  AddBullet(BulletType);
-}
-
 EBulletType AMagazineAttachment::RemoveBullet() {
   if (!HasAuthority()) {
-    Server_RemoveBullet();
+    QueueAmmoOp(EAmmoOpType::RemoveRounds);
     return EBulletType::None;
   }
 
   EBulletType Out{};
   if (BulletBuffer.Get(Out)) {
-    UE_LOG(LogAttachmentSystem, Warning,
-           TEXT("Magazine %s removed bullet: %s (AmmoCount=%d)"), *GetName(),
-           *BulletTypeToString(Out), GetAmmoCount());
+    ReplicatedContents.Consume(1);
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::RemoveRounds, Out, 1,
+                          GetAmmoCount());
+    UE_LOG(LogAttachmentSystem, VeryVerbose,
+           TEXT("Magazine %s removed bullet %d (AmmoCount=%d)"), *GetName(),
+           static_cast<int32>(Out), GetAmmoCount());
     ReplicatedAmmoCount = GetAmmoCount();
     return Out;
   }
 
-  UE_LOG(LogAttachmentSystem, Warning, TEXT("Magazine %s is EMPTY!"),
+  UE_LOG(LogAttachmentSystem, Verbose, TEXT("Magazine %s is EMPTY!"),
          *GetName());
   return EBulletType::None;
 }
 
-void AMagazineAttachment::Server_RemoveBullet_Implementation() {
-  if (!HasAuthority())
-    return;
-  RemoveBullet();
-}
-
 int32 AMagazineAttachment::GetAmmoCount() const {
   return static_cast<int32>(BulletBuffer.AvailableToRead());
 }
@@ -189,36 +361,96 @@ FString AMagazineAttachment::BulletTypeToString(EBulletType Type) {
 
 void AMagazineAttachment::RemoveBullets(int32 n) {
   if (!HasAuthority()) {
-    Server_RemoveBullets(n);
+    QueueAmmoOp(EAmmoOpType::RemoveRounds, EBulletType::None, n);
     return;
   }
 
   if (n < 0)
     return;
 
-  EBulletType Temp{};
-  if (n > 0 && BulletBuffer.Get(&Temp, n)) // pass pointer to Temp
-  {
-    UE_LOG(LogAttachmentSystem, Warning,
-           TEXT("Magazine %s fully emptied (%d rounds removed)."), *GetName(),
-           n);
+  // Block Get writes n rounds, so it needs n slots of scratch
+  TArray<EBulletType, TInlineAllocator<32>> Temp;
+  Temp.SetNumUninitialized(n);
+  if (n > 0 && BulletBuffer.Get(Temp.GetData(), n)) {
+    ReplicatedContents.Consume(n);
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::RemoveRounds, EBulletType::None,
+                          n, GetAmmoCount());
+    UE_LOG(LogAttachmentSystem, VeryVerbose,
+           TEXT("Magazine %s removed %d rounds."), *GetName(), n);
   } else if (BulletBuffer.IsEmpty()) {
-    UE_LOG(LogAttachmentSystem, Warning, TEXT("Magazine %s already EMPTY."),
+    UE_LOG(LogAttachmentSystem, Verbose, TEXT("Magazine %s already EMPTY."),
            *GetName());
   }
 
   ReplicatedAmmoCount = GetAmmoCount(); // maintains synchronized state
 }
 
-void AMagazineAttachment::Server_RemoveBullets_Implementation(int32 n) {
-  if (!HasAuthority())
-    return;
-  RemoveBullets(n);
+int32 AMagazineAttachment::DrainBullets(const int32 Count,
+                                        TArray<EBulletType> &OutBullets) {
+  if (!HasAuthority() || Count <= 0)
+    return 0;
+
+  const int32 ToRead = FMath::Min(Count, GetAmmoCount());
+  if (ToRead == 0)
+    return 0;
+
+  const int32 Offset = OutBullets.AddUninitialized(ToRead);
+  if (!BulletBuffer.Get(OutBullets.GetData() + Offset, ToRead)) {
+    OutBullets.SetNum(Offset, EAllowShrinking::No);
+    return 0;
+  }
+
+  // One replicated delta for the whole burst
+  ReplicatedContents.Consume(ToRead);
+  ReplicatedAmmoCount = GetAmmoCount();
+  TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::RemoveRounds, OutBullets[Offset],
+                        ToRead, ReplicatedAmmoCount);
+  return ToRead;
+}
+
+bool AMagazineAttachment::ApplyAmmoOp(const FAmmoOp &Op) {
+  switch (Op.Op) {
+  case EAmmoOpType::LoadRounds: {
+    // Rounds past capacity are refused, as AddBullet would
+    const int32 ToLoad =
+        FMath::Min(Op.Count, MagazineCapacity - GetAmmoCount());
+    for (int32 i = 0; i < ToLoad; ++i) {
+      BulletBuffer.Put(Op.BulletType);
+    }
+    ReplicatedContents.Load(Op.BulletType, ToLoad);
+    ReplicatedAmmoCount = GetAmmoCount();
+    TRACE_ATTACHMENT_AMMO(this, EAmmoOpType::LoadRounds, Op.BulletType, ToLoad,
+                          ReplicatedAmmoCount);
+    return true;
+  }
+  case EAmmoOpType::RemoveRounds:
+    RemoveBullets(FMath::Min(Op.Count, GetAmmoCount()));
+    return true;
+  default:
+    return false;
+  }
 }
 
 void AMagazineAttachment::OnRep_AmmoCount() {
-  UE_LOG(LogAttachmentSystem, Log, TEXT("Magazine %s ammo synced: %d"),
-         *GetName(), ReplicatedAmmoCount);
+  UE_LOG(LogAttachmentSystem, VeryVerbose,
+         TEXT("Magazine %s ammo synced: %d"), *GetName(), ReplicatedAmmoCount);
+}
+
+void AMagazineAttachment::OnRep_Contents() {
+  UE_LOG(LogAttachmentSystem, VeryVerbose,
+         TEXT("Magazine %s contents synced: %d"), *GetName(),
+         ReplicatedContents.GetRounds().Num());
+}
+
+void AMagazineAttachment::ResetForPool() {
+  Super::ResetForPool();
+
+  // Local drain, no RPC: pooling only happens on the server
+  EBulletType Discard{};
+  while (BulletBuffer.Get(Discard)) {
+  }
+  ReplicatedContents.ConsumeAll();
+  ReplicatedAmmoCount = 0;
 }
 
 void AMagazineAttachment::LogBufferNonDestructive(const FString &Context) {
@@ -256,6 +488,7 @@ void AMagazineAttachment::EnqueueNTimes(EBulletType Type, int32 Count) {
              *BulletTypeToString(Type));
       break;
     }
+    ReplicatedContents.Load(Type);
   }
 }
 
@@ -263,6 +496,7 @@ void AMagazineAttachment::DequeueNTimes(int32 Count) {
   for (int32 i = 0; i < Count; i++) {
     EBulletType Out{};
     if (BulletBuffer.Get(Out)) {
+      ReplicatedContents.Consume(1);
       UE_LOG(LogAttachmentSystem, Warning, TEXT("Removed: %s"),
              *BulletTypeToString(Out));
     } else {
@@ -50,6 +50,38 @@ int32 ARailAttachment::GetSlotFromDistance(float Distance) const {
   return SlotIndex;
 }
 
+float ARailAttachment::GetDistanceFromSlot(const int32 SlotIndex) const {
+  if (!RailSpline || NumSlots <= 1)
+    return 0.f;
+
+  const float RailLength = RailSpline->GetSplineLength();
+  const int32 ClampedIndex = FMath::Clamp(SlotIndex, 0, NumSlots - 1);
+
+  // GetSlotFromDistance floors Distance / RailLength * (NumSlots - 1), so the
+  // first distance landing on a slot is the exact multiple.
+  return RailLength * static_cast<float>(ClampedIndex) /
+         static_cast<float>(NumSlots - 1);
+}
+
+uint64 ARailAttachment::GetFreeStartSlotMask(const int32 ItemSize) const {
+  const int32 UsableSlots = FMath::Min(NumSlots, MaxSlots);
+  if (ItemSize <= 0 || ItemSize > UsableSlots)
+    return 0ull;
+
+  // Free slots inside the rail
+  const uint64 FreeMask = ~OccupancyMask & MakeMask(0, UsableSlots);
+
+  // A start slot is valid if it and the next (ItemSize - 1) slots are free:
+  // AND the free mask with itself shifted down once per extra slot.
+  uint64 StartMask = FreeMask;
+  for (int32 Offset = 1; Offset < ItemSize && StartMask; ++Offset) {
+    StartMask &= FreeMask >> Offset;
+  }
+
+  // Item must end inside the rail
+  return StartMask & MakeMask(0, UsableSlots - ItemSize + 1);
+}
+
 bool ARailAttachment::PlaceAttachment(AAttachment *Attachment) {
   if (!HasAuthority()) {
     Server_PlaceAttachment(Attachment);
@@ -123,4 +155,11 @@ FTransform ARailAttachment::GetSlotTransform(const int32 SlotIndex) const {
   // Get the world transform at this distance along the spline
   return RailSpline->GetTransformAtDistanceAlongSpline(
       Distance, ESplineCoordinateSpace::World);
+}
+
+void ARailAttachment::ResetForPool() {
+  Super::ResetForPool();
+
+  OccupancyMask = 0;
+  MountedAttachments.Reset();
 }
\ No newline at end of file
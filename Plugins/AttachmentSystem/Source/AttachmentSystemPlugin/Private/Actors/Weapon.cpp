@@ -3,11 +3,30 @@
 #include "Actors/MagazineAttachment.h"
 #include "Actors/BarrelAttachment.h"
 #include "Components/WeaponBuilderComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/AttachmentSystemTrace.h"
 #include "Misc/AttachmentSystemTypes.h"
 #include "Net/UnrealNetwork.h"
+#include "Subsystems/AttachmentWearSubsystem.h"
+#include "Subsystems/WeaponSignificanceSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Fire"), STAT_WeaponFire,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Weapon Chamber"), STAT_WeaponChamber,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Weapon Batch"), STAT_WeaponBatch,
+                   STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Fired"), STAT_ShotsFired,
+                           STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rounds Chambered"), STAT_RoundsChambered,
+                           STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fire Batches"), STAT_FireBatches,
+                           STATGROUP_AttachmentSystem);
 
 AWeapon::AWeapon() {
-  PrimaryActorTick.bCanEverTick = true;
+  // Firing runs on timers; nothing needs a per-frame tick
+  PrimaryActorTick.bCanEverTick = false;
 
   Root = CreateDefaultSubobject<USceneComponent>(FName(TEXT("Root")));
   SetRootComponent(Root);
@@ -18,6 +37,8 @@ AWeapon::AWeapon() {
 
   WeaponBuilderComponent->OnWeaponBuilt.AddDynamic(this,
                                                    &AWeapon::HandleWeaponBuilt);
+  WeaponBuilderComponent->OnWeaponCleared.AddDynamic(
+      this, &AWeapon::HandleWeaponCleared);
 
   BatchSendInterval = 0.15f;
   PendingShots = 0;
@@ -26,6 +47,21 @@ AWeapon::AWeapon() {
 void AWeapon::BeginPlay() {
   Super::BeginPlay();
   WeaponCurrentState.Durability = 100.f;
+  RefreshBaseStats();
+  RefreshWearCoefficients();
+
+  if (UWeaponSignificanceSubsystem *Significance =
+          GetWorld()->GetSubsystem<UWeaponSignificanceSubsystem>()) {
+    Significance->RegisterWeapon(this);
+  }
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  if (UWeaponSignificanceSubsystem *Significance =
+          GetWorld()->GetSubsystem<UWeaponSignificanceSubsystem>()) {
+    Significance->UnregisterWeapon(this);
+  }
+  Super::EndPlay(EndPlayReason);
 }
 
 void AWeapon::GetLifetimeReplicatedProps(
@@ -34,25 +70,30 @@ void AWeapon::GetLifetimeReplicatedProps(
 
   DOREPLIFETIME(AWeapon, CurrentReloadStage);
   DOREPLIFETIME(AWeapon, bHasMagazineAttached);
+  DOREPLIFETIME(AWeapon, CurrentMagazine);
+  DOREPLIFETIME(AWeapon, CurrentBarrel);
 }
 
-void AWeapon::Tick(float DeltaTime) { Super::Tick(DeltaTime); }
-
 void AWeapon::HandleWeaponBuilt(const TArray<AAttachment*>& SpawnedAttachments) {
+  for (AAttachment* Old : WeaponCurrentState.ActiveAttachments) {
+    if (IsValid(Old))
+      Old->OnDurabilityChanged.RemoveAll(this);
+  }
+  DurabilityTracker.Reset();
+
   WeaponCurrentState.ActiveAttachments.Reset();
   WeaponCurrentState.ActiveAttachmentMeshes.Reset();
 
   CurrentMagazine = nullptr;
   CurrentBarrel = nullptr;
 
+  // New attachment set: drop every old source, then fold in the new ones
+  StatEngine.ClearModifiers();
+
   for (AAttachment* Attachment : SpawnedAttachments) {
     if (!Attachment) continue;
 
-    WeaponCurrentState.ActiveAttachments.Add(Attachment);
-
-    if (USkeletalMeshComponent* Mesh = Attachment->GetMeshComponent()) {
-      WeaponCurrentState.ActiveAttachmentMeshes.Add(Mesh);
-    }
+    RegisterActiveAttachment(Attachment);
 
     if (AMagazineAttachment* Mag = Cast<AMagazineAttachment>(Attachment)) {
       CurrentMagazine = Mag;
@@ -69,58 +110,137 @@ void AWeapon::HandleWeaponBuilt(const TArray<AAttachment*>& SpawnedAttachments)
          WeaponCurrentState.ActiveAttachmentMeshes.Num())
 }
 
+void AWeapon::HandleWeaponCleared() {
+  // Same reset as a rebuild, with no parts to fold back in
+  HandleWeaponBuilt(TArray<AAttachment*>());
+}
+
+void AWeapon::RegisterActiveAttachment(AAttachment* Attachment) {
+  if (!Attachment || WeaponCurrentState.ActiveAttachments.Contains(Attachment))
+    return;
+
+  WeaponCurrentState.ActiveAttachments.Add(Attachment);
+  AddAttachmentStats(Attachment);
+  TrackAttachmentDurability(Attachment);
+
+  if (USkeletalMeshComponent* Mesh = Attachment->GetMeshComponent()) {
+    WeaponCurrentState.ActiveAttachmentMeshes.Add(Mesh);
+  }
+
+  if (WeaponBuilderComponent) {
+    WeaponBuilderComponent->RequestRebake();
+  }
+}
+
+void AWeapon::UnregisterActiveAttachment(AAttachment* Attachment) {
+  if (!Attachment ||
+      WeaponCurrentState.ActiveAttachments.Remove(Attachment) == 0)
+    return;
+
+  RemoveAttachmentStats(Attachment);
+  UntrackAttachmentDurability(Attachment);
+  WeaponCurrentState.ActiveAttachmentMeshes.Remove(
+      Attachment->GetMeshComponent());
+
+  if (CurrentMagazine == Attachment)
+    CurrentMagazine = nullptr;
+  if (CurrentBarrel == Attachment)
+    CurrentBarrel = nullptr;
+
+  if (WeaponBuilderComponent) {
+    WeaponBuilderComponent->RequestRebake();
+  }
+}
+
 /* =============================
  * Durability
  * ============================= */
 
-float AWeapon::GetWeaponDurability(EWeaponDurabilityMode Mode) {
+float AWeapon::GetWeaponDurability(EWeaponDurabilityMode Mode) const {
   if (Mode == EWeaponDurabilityMode::Average &&
       WeaponInfo.DefaultDurabilityMode != EWeaponDurabilityMode::Average) {
     Mode = WeaponInfo.DefaultDurabilityMode;
   }
 
-  if (!IsValid(WeaponBuilderComponent))
-    return 0.f;
-  const TArray<AAttachment*>& SpawnedAttachments =
-      WeaponBuilderComponent->GetSpawnedAttachments();
-  if (SpawnedAttachments.Num() == 0)
-    return 0.f;
-
-  float Total = 0.f;
-  float MinDurability = FLT_MAX;
-  float MaxDurability = -FLT_MAX;
-  int32 ValidCount = 0;
-
-  for (const AAttachment* Attachment : SpawnedAttachments) {
-    if (!Attachment) continue;
-    const float CurrentDurability = Attachment->GetDurability();
-    Total += CurrentDurability;
-    MinDurability = FMath::Min(MinDurability, CurrentDurability);
-    MaxDurability = FMath::Max(MaxDurability, CurrentDurability);
-    ++ValidCount;
-  }
-
-  if (ValidCount == 0)
-    return 0.f;
-
   switch (Mode) {
-  case EWeaponDurabilityMode::Average:
-    WeaponCurrentState.Durability = Total / ValidCount;
-    break;
   case EWeaponDurabilityMode::Minimum:
-    WeaponCurrentState.Durability = MinDurability;
-    break;
+    return DurabilityTracker.GetMin();
   case EWeaponDurabilityMode::Maximum:
-    WeaponCurrentState.Durability = MaxDurability;
-    break;
+    return DurabilityTracker.GetMax();
+  case EWeaponDurabilityMode::Average:
+  default:
+    return DurabilityTracker.GetAverage();
   }
+}
 
-  return WeaponCurrentState.Durability;
+void AWeapon::TrackAttachmentDurability(AAttachment* Attachment) {
+  DurabilityTracker.Add(Attachment->GetDurability());
+  Attachment->OnDurabilityChanged.AddUObject(
+      this, &AWeapon::HandleAttachmentDurabilityChanged);
 }
 
-void AWeapon::ModifyDurability(float Delta) {
-  WeaponCurrentState.Durability =
-      FMath::Clamp(WeaponCurrentState.Durability + Delta, 0.f, 100.f);
+void AWeapon::UntrackAttachmentDurability(AAttachment* Attachment) {
+  Attachment->OnDurabilityChanged.RemoveAll(this);
+  DurabilityTracker.Remove(Attachment->GetDurability());
+}
+
+void AWeapon::HandleAttachmentDurabilityChanged(AAttachment* Attachment,
+                                                const float OldDurability,
+                                                const float NewDurability) {
+  DurabilityTracker.Update(OldDurability, NewDurability);
+}
+
+/* =============================
+ * Stats
+ * ============================= */
+
+float AWeapon::GetWeaponStat(const EWeaponStat Stat) const {
+  return StatEngine.GetStat(Stat);
+}
+
+void AWeapon::AddAttachmentStats(AAttachment* Attachment) {
+  if (!Attachment)
+    return;
+  StatEngine.AddModifiers(Attachment, Attachment->GetStatModifiers());
+}
+
+void AWeapon::RemoveAttachmentStats(AAttachment* Attachment) {
+  if (!Attachment)
+    return;
+  StatEngine.RemoveModifiers(Attachment);
+}
+
+void AWeapon::RefreshBaseStats() {
+  StatEngine.SetBaseStats(WeaponInfo.BaseStats);
+}
+
+void AWeapon::RefreshWearCoefficients() {
+  WearCoefficientTable.Init(1.f, NumAttachmentCategories);
+  for (const TPair<EAttachmentCategory, float>& Pair :
+       WeaponInfo.WearCoefficients) {
+    const int32 Index = static_cast<int32>(Pair.Key);
+    if (WearCoefficientTable.IsValidIndex(Index))
+      WearCoefficientTable[Index] = Pair.Value;
+  }
+}
+
+void AWeapon::ApplyPendingWear() {
+  if (PendingWearShots <= 0)
+    return;
+
+  if (UAttachmentWearSubsystem* Wear =
+          GetWorld() ? GetWorld()->GetSubsystem<UAttachmentWearSubsystem>()
+                     : nullptr) {
+    if (WearCoefficientTable.Num() != NumAttachmentCategories)
+      RefreshWearCoefficients();
+
+    Wear->ApplyBatchWear(WeaponCurrentState.ActiveAttachments,
+                         PendingWearShots, WeaponInfo.WearPerShot,
+                         WearCoefficientTable);
+    WeaponCurrentState.Durability = GetWeaponDurability();
+  }
+
+  PendingWearShots = 0;
 }
 
 /* =============================
@@ -129,18 +249,21 @@ void AWeapon::ModifyDurability(float Delta) {
 
 void AWeapon::StartFiring() {
   PendingShots = 0;
-  if (!GetWorldTimerManager().IsTimerActive(BatchTimerHandle)) {
+  if (!bBatchFiring) {
+    // Replaces a pending one-shot wear window; its shots carry over
+    bBatchFiring = true;
     GetWorldTimerManager().SetTimer(BatchTimerHandle, this,
                                     &AWeapon::ProcessBatch,
                                     BatchSendInterval, true);
-    UE_LOG(LogAttachmentSystem, Log, TEXT("Batch firing started for %s"), *GetName());
+    UE_LOG(LogAttachmentSystem, Verbose, TEXT("Batch firing started for %s"), *GetName());
   }
 }
 
 void AWeapon::StopFiring() {
   ProcessBatch();
   GetWorldTimerManager().ClearTimer(BatchTimerHandle);
-  UE_LOG(LogAttachmentSystem, Log, TEXT("Batch firing stopped for %s"), *GetName());
+  bBatchFiring = false;
+  UE_LOG(LogAttachmentSystem, Verbose, TEXT("Batch firing stopped for %s"), *GetName());
 }
 
 void AWeapon::OnShotFired() {
@@ -148,12 +271,30 @@ void AWeapon::OnShotFired() {
 }
 
 void AWeapon::ProcessBatch() {
-  if (PendingShots > 0 && CurrentMagazine) {
-    CurrentMagazine->RemoveBullets(PendingShots);
-    UE_LOG(LogAttachmentSystem, Log, TEXT("Processed batch of %d shots on %s"),
-           PendingShots, *GetName());
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_WeaponBatch);
+
+  // Only windows that fired count as batches
+  if (PendingShots > 0) {
+    INC_DWORD_STAT(STAT_FireBatches);
+    const int32 Shots = FMath::Min(PendingShots, MaxShotsPerBatch);
+
+    if (!HasAuthority()) {
+      // The server owns the ammo: send the window's count whatever this
+      // client has resolved locally
+      Server_FireBurst(Shots);
+    } else if (CurrentBarrel) {
+      // One bulk draw for the whole window (keeps the bullet types)
+      FireBurst(Shots);
+    } else if (CurrentMagazine) {
+      CurrentMagazine->RemoveBullets(Shots);
+    }
+    UE_LOG(LogAttachmentSystem, Verbose,
+           TEXT("Processed batch of %d shots on %s"), Shots, *GetName());
     PendingShots = 0;
   }
+
+  // Wear is paid once per batch, not per bullet
+  ApplyPendingWear();
 }
 
 /* =============================
@@ -298,16 +439,95 @@ TArray<EBulletType> AWeapon::FireFromChamber() {
     return {};
   if (!CurrentBarrel || !CurrentBarrel->HasRoundChambered())
     return {};
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_WeaponFire);
+  INC_DWORD_STAT(STAT_ShotsFired);
   TArray<EBulletType> FiredRounds = CurrentBarrel->GetChamberedRounds();
   CurrentBarrel->ClearChamber();
   TryChamberFromMagazine();
-  ModifyDurability(-0.5f);
+  QueueWear(1);
   OnWeaponFired.Broadcast(FiredRounds);
-  UE_LOG(LogAttachmentSystem, Log, TEXT("Weapon %s fired %d rounds"),
+  TRACE_ATTACHMENT_FIRE(this, 1, FiredRounds.Num(), FiredRounds[0]);
+  UE_LOG(LogAttachmentSystem, VeryVerbose, TEXT("Weapon %s fired %d rounds"),
          *GetName(), FiredRounds.Num());
   return FiredRounds;
 }
 
+bool AWeapon::Server_FireBurst_Validate(const int32 Count) {
+  return Count > 0 && Count <= MaxShotsPerBatch;
+}
+
+void AWeapon::Server_FireBurst_Implementation(const int32 Count) {
+  // Never more shots than the weapon holds (chamber + magazine)
+  const int32 Available = (HasRoundChambered() ? 1 : 0) + GetAmmoCount();
+  const int32 Shots = FMath::Min(Count, Available);
+  if (Shots > 0) {
+    FireBurst(Shots);
+  }
+}
+
+TArray<EBulletType> AWeapon::FireBurst(int32 Count) {
+  if (!HasAuthority())
+    return {};
+  if (!CurrentBarrel || Count <= 0)
+    return {};
+
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_WeaponFire);
+
+  TArray<EBulletType> FiredRounds;
+  int32 ShotsFired = 0;
+
+  // Whatever is chambered goes first (a shell may hold several pellets)
+  if (CurrentBarrel->HasRoundChambered()) {
+    FiredRounds.Append(CurrentBarrel->GetChamberedRounds());
+    ++ShotsFired;
+    --Count;
+  }
+
+  // One block draw: the rest of the burst plus the round to re-chamber
+  EBulletType NextChambered = EBulletType::None;
+  if (CurrentMagazine) {
+    const int32 Drawn =
+        CurrentMagazine->DrainBullets(Count + 1, FiredRounds);
+    const int32 FromMagazine = FMath::Min(Drawn, Count);
+    ShotsFired += FromMagazine;
+
+    if (Drawn > Count) {
+      NextChambered = FiredRounds.Pop(EAllowShrinking::No);
+    }
+  }
+
+  if (NextChambered != EBulletType::None) {
+    CurrentBarrel->SetChamberedRounds({NextChambered});
+  } else if (CurrentBarrel->HasRoundChambered()) {
+    CurrentBarrel->ClearChamber();
+  }
+
+  if (ShotsFired == 0)
+    return {};
+
+  INC_DWORD_STAT_BY(STAT_ShotsFired, ShotsFired);
+  QueueWear(ShotsFired);
+  OnWeaponFired.Broadcast(FiredRounds);
+  TRACE_ATTACHMENT_FIRE(this, ShotsFired, FiredRounds.Num(),
+                        FiredRounds.Num() > 0 ? FiredRounds[0]
+                                              : EBulletType::None);
+  UE_LOG(LogAttachmentSystem, VeryVerbose,
+         TEXT("Weapon %s burst fired %d shots (%d rounds)"), *GetName(),
+         ShotsFired, FiredRounds.Num());
+  return FiredRounds;
+}
+
+void AWeapon::QueueWear(const int32 Shots) {
+  // Wear is deferred to the next batch; open a one-shot window if no
+  // batch timer is running
+  PendingWearShots += Shots;
+  if (!GetWorldTimerManager().IsTimerActive(BatchTimerHandle)) {
+    GetWorldTimerManager().SetTimer(BatchTimerHandle, this,
+                                    &AWeapon::ProcessBatch,
+                                    BatchSendInterval, false);
+  }
+}
+
 bool AWeapon::TryChamberFromMagazine() {
   if (!HasAuthority())
     return false;
@@ -315,13 +535,16 @@ bool AWeapon::TryChamberFromMagazine() {
     return false;
   if (CurrentBarrel->HasRoundChambered())
     return true;
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_WeaponChamber);
   EBulletType NextRound = CurrentMagazine->RemoveBullet();
   if (NextRound != EBulletType::None) {
     TArray<EBulletType> Rounds;
     Rounds.Add(NextRound);
     CurrentBarrel->SetChamberedRounds(Rounds);
-    UE_LOG(LogAttachmentSystem, Log, TEXT("Weapon %s chambered round %s"),
-           *GetName(), *UEnum::GetValueAsString(NextRound));
+    INC_DWORD_STAT(STAT_RoundsChambered);
+    UE_LOG(LogAttachmentSystem, VeryVerbose,
+           TEXT("Weapon %s chambered round %d"), *GetName(),
+           static_cast<int32>(NextRound));
     return true;
   }
   return false;
@@ -427,4 +650,35 @@ EBulletType AWeapon::GetChamberedRound() const {
 
 bool AWeapon::HasRoundChambered() const {
   return (CurrentBarrel && CurrentBarrel->HasRoundChambered());
+}
+
+/* =============================
+ * Detail / Significance
+ * ============================= */
+
+void AWeapon::SetDetailTier(const EWeaponDetailTier NewTier) {
+  if (DetailTier == NewTier)
+    return;
+  DetailTier = NewTier;
+
+  if (!WeaponBuilderComponent)
+    return;
+
+  // Merged falls back to Reduced when the builder has no bake
+  WeaponBuilderComponent->SetSmallPartsHidden(NewTier !=
+                                              EWeaponDetailTier::Full);
+  WeaponBuilderComponent->SetBakedViewEnabled(NewTier ==
+                                              EWeaponDetailTier::Merged);
+}
+
+bool AWeapon::IsOwnedByLocalPlayer() const {
+  for (const AActor *Owner = GetOwner(); Owner; Owner = Owner->GetOwner()) {
+    if (const APawn *Pawn = Cast<APawn>(Owner)) {
+      return Pawn->IsLocallyControlled();
+    }
+    if (const AController *Controller = Cast<AController>(Owner)) {
+      return Controller->IsLocalController();
+    }
+  }
+  return false;
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AttachmentSystemPlugin.h"
+#include "Misc/AttachmentSocketTable.h"
 
 #define LOCTEXT_NAMESPACE "FAttachmentSystemModule"
 
-void FAttachmentSystemPluginModule::StartupModule() {}
+void FAttachmentSystemPluginModule::StartupModule() {
+  // Category → socket FNames, built once instead of per lookup
+  AttachmentSockets::Initialize();
+}
 
 void FAttachmentSystemPluginModule::ShutdownModule() {}
 
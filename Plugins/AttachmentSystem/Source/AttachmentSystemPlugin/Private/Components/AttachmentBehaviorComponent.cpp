@@ -0,0 +1,10 @@
+#include "Components/AttachmentBehaviorComponent.h"
+
+UAttachmentBehaviorComponent::UAttachmentBehaviorComponent() {
+  // Opt in through UAttachmentTickSubsystem instead
+  PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAttachmentBehaviorComponent::TickBehavior(const float DeltaTime) {
+  ReceiveTickBehavior(DeltaTime);
+}
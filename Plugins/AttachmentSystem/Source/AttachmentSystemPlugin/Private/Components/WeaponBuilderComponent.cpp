@@ -5,17 +5,66 @@
 #include "Actors/Attachment.h"
 #include "Actors/RailAttachment.h"
 #include "Actors/Weapon.h"
+#include "Components/AttachmentBehaviorComponent.h"
 #include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/AttachmentSocketMapping.h"
+#include "Misc/AttachmentSocketTable.h"
+#include "Misc/AttachmentSystemTrace.h"
+#include "Misc/WeaponMeshBaker.h"
+#include "Subsystems/AttachmentPoolSubsystem.h"
+#include "Subsystems/AttachmentTickSubsystem.h"
+#include "Subsystems/WeaponBuildPlanCache.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Weapon"), STAT_BuildWeapon,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Build Weapon Graph"), STAT_BuildWeaponGraph,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Build BFS Expand"), STAT_BuildBFSExpand,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Replay Build Plan"), STAT_ReplayBuildPlan,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Spawn Attachment"), STAT_SpawnAttachment,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Rail Sweep"), STAT_RailSweep,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("Rail Overlap Query"), STAT_RailOverlapQuery,
+                   STATGROUP_AttachmentSystem);
+DECLARE_CYCLE_STAT(TEXT("OnWeaponBuilt Broadcast"),
+                   STAT_OnWeaponBuiltBroadcast, STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Build Nodes Expanded"),
+                           STAT_BuildNodesExpanded,
+                           STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attachments Acquired"),
+                           STAT_AttachmentsAcquired,
+                           STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rail Overlap Queries"),
+                           STAT_RailOverlapQueries,
+                           STATGROUP_AttachmentSystem);
 
 UWeaponBuilderComponent::UWeaponBuilderComponent() {
-  PrimaryComponentTick.bCanEverTick = true;
+  PrimaryComponentTick.bCanEverTick = false;
   SetIsReplicatedByDefault(true);
 }
 
+#if WITH_EDITOR
+void UWeaponBuilderComponent::PostEditChangeProperty(
+    FPropertyChangedEvent &PropertyChangedEvent) {
+  Super::PostEditChangeProperty(PropertyChangedEvent);
+
+  // SocketMapping swapped: resolve again on the next lookup
+  bSocketTableResolved = false;
+}
+#endif
+
 void UWeaponBuilderComponent::BeginPlay() {
   Super::BeginPlay();
   Weapon = Cast<AWeapon>(GetOwner());
+  RefreshSocketTable();
 }
 
 void UWeaponBuilderComponent::EndPlay(
@@ -24,16 +73,11 @@ void UWeaponBuilderComponent::EndPlay(
   Super::EndPlay(EndPlayReason);
 }
 
-void UWeaponBuilderComponent::TickComponent(
-    const float DeltaTime, const ELevelTick TickType,
-    FActorComponentTickFunction *ThisTickFunction) {
-  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-}
-
 void UWeaponBuilderComponent::GetLifetimeReplicatedProps(
     TArray<FLifetimeProperty> &OutLifetimeProps) const {
   Super::GetLifetimeReplicatedProps(OutLifetimeProps);
   DOREPLIFETIME(ThisClass, Weapon);
+  DOREPLIFETIME(ThisClass, CompactParts);
 }
 
 void UWeaponBuilderComponent::BuildWeapon() {
@@ -43,8 +87,124 @@ void UWeaponBuilderComponent::BuildWeapon() {
     return;
   }
 
-  // Clear old attachments
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_BuildWeapon);
+
+  // Clear old attachments (also cancels a build still streaming)
   ClearWeapon();
+  RailPlacementStats = FRailPlacementStats();
+  RefreshSocketTable();
+
+  // Gather every mesh the graph will need, then stream them in one batch
+  TArray<FSoftObjectPath> MeshPaths;
+  TSet<UClass *> VisitedClasses;
+  for (const TSubclassOf<AAttachment> &AttachmentClass : BaseAttachments) {
+    GatherAttachmentMeshes(AttachmentClass, VisitedClasses, MeshPaths);
+  }
+
+  if (MeshPaths.Num() == 0) {
+    // Everything already resident, build right away
+    BuildWeaponGraph();
+    return;
+  }
+
+  UE_LOG(LogAttachmentSystem, Verbose,
+         TEXT("Streaming %d attachment meshes before building %s"),
+         MeshPaths.Num(), *GetOwner()->GetName());
+
+  PendingMeshLoad = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+      MoveTemp(MeshPaths),
+      FStreamableDelegate::CreateUObject(this, &ThisClass::BuildWeaponGraph));
+
+  if (PendingMeshLoad.IsValid() && PendingMeshLoad->IsLoadingInProgress()) {
+    PendingMeshLoad->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(
+        this, &ThisClass::HandleMeshLoadUpdate));
+  }
+}
+
+bool UWeaponBuilderComponent::IsBuildPending() const {
+  return PendingMeshLoad.IsValid() && PendingMeshLoad->IsLoadingInProgress();
+}
+
+void UWeaponBuilderComponent::GatherAttachmentMeshes(
+    const TSubclassOf<AAttachment> AttachmentClass,
+    TSet<UClass *> &VisitedClasses, TArray<FSoftObjectPath> &OutMeshPaths) {
+  if (!*AttachmentClass || VisitedClasses.Contains(AttachmentClass))
+    return;
+  VisitedClasses.Add(AttachmentClass);
+
+  // The class defaults carry both the DataTable row and the child links
+  const AAttachment *Defaults = AttachmentClass->GetDefaultObject<AAttachment>();
+  if (!Defaults)
+    return;
+
+  if (IsValid(Defaults->AttachmentDataTable)) {
+    const FAttachmentInfo *Row =
+        Defaults->AttachmentDataTable->FindRow<FAttachmentInfo>(
+            Defaults->ID, TEXT("Gathering attachment meshes"),
+            /*bWarnIfRowMissing=*/false);
+
+    // Only queue meshes that are not loaded yet
+    if (Row && !Row->Mesh.IsNull() && !Row->Mesh.IsValid()) {
+      OutMeshPaths.AddUnique(Row->Mesh.ToSoftObjectPath());
+    }
+    if (Row && !Row->StaticMesh.IsNull() && !Row->StaticMesh.IsValid()) {
+      OutMeshPaths.AddUnique(Row->StaticMesh.ToSoftObjectPath());
+    }
+  }
+
+  for (const FAttachmentLink &Link : Defaults->ChildrenLinks) {
+    for (const TSubclassOf<AAttachment> &ChildClass : Link.ChildClasses) {
+      GatherAttachmentMeshes(ChildClass, VisitedClasses, OutMeshPaths);
+    }
+  }
+}
+
+void UWeaponBuilderComponent::HandleMeshLoadUpdate(
+    TSharedRef<FStreamableHandle> Handle) {
+  OnWeaponBuildProgress.Broadcast(Handle->GetProgress());
+}
+
+void UWeaponBuilderComponent::CancelPendingBuild() {
+  if (PendingMeshLoad.IsValid()) {
+    PendingMeshLoad->CancelHandle();
+    PendingMeshLoad.Reset();
+  }
+}
+
+void UWeaponBuilderComponent::BuildWeaponGraph() {
+  if (!GetWorld() || !GetOwner())
+    return;
+
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_BuildWeaponGraph);
+
+  // Same configuration built before → replay its flat plan, no search
+  UWeaponBuildPlanCache *PlanCache =
+      (bUseBuildPlanCache && GEngine)
+          ? GEngine->GetEngineSubsystem<UWeaponBuildPlanCache>()
+          : nullptr;
+  if (PlanCache) {
+    if (const FWeaponBuildPlan *Plan =
+            PlanCache->FindPlan(BaseAttachments, SocketMapping)) {
+      ReplayBuildPlan(*Plan);
+      if (bCompactBuild) {
+        CompactAttachments();
+      }
+      RequestRebake();
+
+      OnWeaponBuildProgress.Broadcast(1.f);
+      {
+        ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_OnWeaponBuiltBroadcast);
+        OnWeaponBuilt.Broadcast(SpawnedAttachments);
+      }
+      return;
+    }
+  }
+
+  // Record every registered node so the next build can skip the BFS
+  FWeaponBuildPlan RecordedPlan;
+  RecordedPlan.RootClasses = BaseAttachments;
+  RecordedPlan.SocketMapping = SocketMapping;
+  TMap<AAttachment *, int32> StepIndexByAttachment;
 
   TSet<AAttachment *> Visited;
   TQueue<AAttachment *> Queue;
@@ -54,14 +214,7 @@ void UWeaponBuilderComponent::BuildWeapon() {
     if (!*AttachmentClass)
       continue;
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Owner = GetOwner();
-    SpawnParams.SpawnCollisionHandlingOverride =
-        ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-    AAttachment *RootInstance = GetWorld()->SpawnActor<AAttachment>(
-        AttachmentClass, FVector::ZeroVector, FRotator::ZeroRotator,
-        SpawnParams);
+    AAttachment *RootInstance = AcquireAttachment(AttachmentClass);
     if (!RootInstance)
       continue;
 
@@ -77,8 +230,11 @@ void UWeaponBuilderComponent::BuildWeapon() {
     Queue.Enqueue(RootInstance);
     Visited.Add(RootInstance);
 
-    SpawnedAttachments.Add(RootInstance);
-    SpawnedMeshes.Add(RootInstance, RootInstance->MeshComponent);
+    RegisterAttachment(RootInstance, RootInstance->MeshComponent);
+
+    FWeaponBuildStep &RootStep = RecordedPlan.Steps.AddDefaulted_GetRef();
+    RootStep.AttachmentClass = AttachmentClass;
+    StepIndexByAttachment.Add(RootInstance, RecordedPlan.Steps.Num() - 1);
   }
 
   // BFS traversal for children
@@ -88,23 +244,22 @@ void UWeaponBuilderComponent::BuildWeapon() {
     if (!Current)
       continue;
 
+    ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_BuildBFSExpand);
+    INC_DWORD_STAT(STAT_BuildNodesExpanded);
+
     USkeletalMeshComponent *ParentMesh = Current->MeshComponent;
 
-    for (FAttachmentLink &Link : Current->ChildrenLinks) {
+    for (int32 LinkIndex = 0; LinkIndex < Current->ChildrenLinks.Num();
+         ++LinkIndex) {
+      FAttachmentLink &Link = Current->ChildrenLinks[LinkIndex];
+
       // Spawn child instances if needed
       if (Link.ChildInstances.Num() == 0 && Link.ChildClasses.Num() > 0) {
         for (const TSubclassOf<AAttachment> &ChildClass : Link.ChildClasses) {
           if (!*ChildClass)
             continue;
 
-          FActorSpawnParameters SpawnParams;
-          SpawnParams.Owner = GetOwner();
-          SpawnParams.SpawnCollisionHandlingOverride =
-              ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-          AAttachment *NewChild = GetWorld()->SpawnActor<AAttachment>(
-              ChildClass, FVector::ZeroVector, FRotator::ZeroRotator,
-              SpawnParams);
+          AAttachment *NewChild = AcquireAttachment(ChildClass);
 
           if (NewChild) {
             Link.ChildInstances.Add(NewChild);
@@ -123,7 +278,7 @@ void UWeaponBuilderComponent::BuildWeapon() {
         USkeletalMeshComponent *ChildMesh = ChildInstance->MeshComponent;
 
         // Socket by category
-        FAttachmentInfo ChildInfo = ChildInstance->GetAttachmentInfo();
+        const FAttachmentInfo &ChildInfo = ChildInstance->GetAttachmentInfo();
         FName TargetSocket = GetSocketFromCategory(ChildInfo.Category);
 
         bool bShouldRegister =
@@ -132,77 +287,16 @@ void UWeaponBuilderComponent::BuildWeapon() {
         // --- Case 1: Parent is a rail ---
         if (ARailAttachment *Rail = Cast<ARailAttachment>(Current)) {
           if (ChildInfo.bUseRail) {
-            const float RailLength = Rail->GetSplineLength();
-            constexpr float Step = 2.5f;
-
-            FVector SocketLoc = ParentMesh->GetSocketLocation(TargetSocket);
-            float SocketZ = SocketLoc.Z;
-
-            bool bPlaced = false;
-            float CurrentDist = 0.f;
-            FTransform TestTransform;
-            TestTransform.SetRotation(FQuat::Identity);
-
-            // Sweep along spline: Start -> End
-            while (CurrentDist <= RailLength) {
-              FVector SplineLoc =
-                  Rail->RailSpline->GetLocationAtDistanceAlongSpline(
-                      CurrentDist, ESplineCoordinateSpace::World);
-
-              // Force Z from socket
-              SplineLoc.Z = SocketZ;
-              TestTransform.SetLocation(SplineLoc);
-
-              // Map dist -> slot
-              int32 MappedSlot = Rail->GetSlotFromDistance(CurrentDist);
-              ChildInstance->StartPosition = MappedSlot;
-
-              // Checks
-              bool bSplineCheck =
-                  (MappedSlot + ChildInstance->Size) <= Rail->NumSlots;
-              bool bMaskCheck = Rail->CanPlaceAttachment(ChildInstance);
-              bool bSocketExists = ParentMesh->DoesSocketExist(TargetSocket);
-              bool bCollisionFree =
-                  !DoesCollideWithRail(TestTransform, ChildMesh, Rail);
-
-              UE_LOG(LogTemp, Warning,
-                     TEXT("Checks for %s -> Spline=%d | Mask=%d | Socket=%d | "
-                          "Collision=%d | Slot=%d/%d"),
-                     *ChildInstance->GetName(), bSplineCheck, bMaskCheck,
-                     bSocketExists, bCollisionFree, MappedSlot,
-                     Rail->NumSlots - 1);
-
-              if (bSplineCheck && bMaskCheck && bSocketExists &&
-                  bCollisionFree) {
-                Rail->PlaceAttachment(ChildInstance);
-
-                ChildMesh->AttachToComponent(
-                    ParentMesh,
-                    FAttachmentTransformRules::SnapToTargetNotIncludingScale,
-                    TargetSocket);
-                ChildMesh->SetWorldLocation(SplineLoc);
-
-                UE_LOG(LogTemp, Log,
-                       TEXT("Attached %s at slot %d (dist=%.2f) on rail %s | "
-                            "Z=%.2f"),
-                       *ChildInstance->GetName(), MappedSlot, CurrentDist,
-                       *Rail->GetName(), SocketZ);
-
-                bPlaced = true;
-                bShouldRegister = true; // NEW
-                break;
-              }
-
-              CurrentDist += Step;
-            }
-
-            if (!bPlaced) {
-              UE_LOG(LogTemp, Warning,
+            if (PlaceOnRail(Rail, ChildInstance, TargetSocket)) {
+              bShouldRegister = true; // NEW
+            } else {
+              TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Rail, -1, false);
+              UE_LOG(LogAttachmentSystem, Verbose,
                      TEXT("Rejected %s -> did not pass checks (rail)"),
                      *ChildInstance->GetName());
 
-              // NEW: destroy failed piece and clear the slot in the array
-              ChildInstance->Destroy();
+              // NEW: return failed piece to the pool and clear the slot
+              ReleaseAttachment(ChildInstance);
               Link.ChildInstances[i] = nullptr;
             }
           } else {
@@ -215,18 +309,20 @@ void UWeaponBuilderComponent::BuildWeapon() {
                   TargetSocket);
               ChildMesh->SetRelativeTransform(Link.Offset);
 
-              UE_LOG(LogTemp, Log,
+              TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Rail, -1, true);
+              UE_LOG(LogAttachmentSystem, Verbose,
                      TEXT("Attached %s using STANDARD pipeline on rail %s"),
                      *ChildInstance->GetName(), *Rail->GetName());
 
               bShouldRegister = true; // NEW: standard attached ok
             } else {
-              // NEW: destroy if we cannot attach even in standard case
+              // NEW: release if we cannot attach even in standard case
+              TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Rail, -1, false);
               UE_LOG(
-                  LogTemp, Warning,
+                  LogAttachmentSystem, Warning,
                   TEXT("Rejected %s -> no valid socket for STANDARD pipeline"),
                   *ChildInstance->GetName());
-              ChildInstance->Destroy();
+              ReleaseAttachment(ChildInstance);
               Link.ChildInstances[i] = nullptr;
             }
           }
@@ -240,16 +336,19 @@ void UWeaponBuilderComponent::BuildWeapon() {
               TargetSocket);
           ChildMesh->SetRelativeTransform(Link.Offset);
 
-          UE_LOG(LogTemp, Log, TEXT("Attached %s to non-rail parent %s"),
+          TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Current, -1, true);
+          UE_LOG(LogAttachmentSystem, Verbose,
+                 TEXT("Attached %s to non-rail parent %s"),
                  *ChildInstance->GetName(), *Current->GetName());
 
           bShouldRegister = true; // NEW
         } else {
-          // NEW: couldn't attach to non-rail either → destroy
-          UE_LOG(LogTemp, Warning,
+          // NEW: couldn't attach to non-rail either → release
+          TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Current, -1, false);
+          UE_LOG(LogAttachmentSystem, Warning,
                  TEXT("Rejected %s -> no valid socket on non-rail parent"),
                  *ChildInstance->GetName());
-          ChildInstance->Destroy();
+          ReleaseAttachment(ChildInstance);
           Link.ChildInstances[i] = nullptr;
         }
 
@@ -261,18 +360,561 @@ void UWeaponBuilderComponent::BuildWeapon() {
           }
 
           if (!SpawnedAttachments.Contains(ChildInstance)) {
-            SpawnedAttachments.Add(ChildInstance);
-            SpawnedMeshes.Add(ChildInstance, ChildMesh);
+            RegisterAttachment(ChildInstance, ChildMesh);
+
+            // Flatten: spawn + attach + final relative transform
+            FWeaponBuildStep &Step = RecordedPlan.Steps.AddDefaulted_GetRef();
+            Step.AttachmentClass = ChildInstance->GetClass();
+            Step.ParentStep = StepIndexByAttachment.FindRef(Current);
+            Step.LinkIndex = LinkIndex;
+            Step.Socket = TargetSocket;
+            Step.RailSlot = (Cast<ARailAttachment>(Current) && ChildInfo.bUseRail)
+                                ? ChildInstance->StartPosition
+                                : INDEX_NONE;
+            if (ChildMesh) {
+              Step.RelativeTransform = ChildMesh->GetRelativeTransform();
+            }
+            StepIndexByAttachment.Add(ChildInstance,
+                                      RecordedPlan.Steps.Num() - 1);
           }
         }
       } // end for i
     } // end for Link
   } // end BFS
 
+  if (PlanCache) {
+    PlanCache->StorePlan(MoveTemp(RecordedPlan));
+  }
+
+  if (bCompactBuild) {
+    CompactAttachments();
+  }
+  RequestRebake();
+
   // --- Broadcast to listeners (e.g. Weapon) that build is complete ---
+  OnWeaponBuildProgress.Broadcast(1.f);
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_OnWeaponBuiltBroadcast);
   OnWeaponBuilt.Broadcast(SpawnedAttachments);
 }
 
+void UWeaponBuilderComponent::ReplayBuildPlan(const FWeaponBuildPlan &Plan) {
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_ReplayBuildPlan);
+
+  // Instance created for each step (nullptr if the step could not run)
+  TArray<AAttachment *, TInlineAllocator<32>> StepInstances;
+  StepInstances.Init(nullptr, Plan.Steps.Num());
+  SpawnedAttachments.Reserve(Plan.Steps.Num());
+
+  for (int32 StepIndex = 0; StepIndex < Plan.Steps.Num(); ++StepIndex) {
+    const FWeaponBuildStep &Step = Plan.Steps[StepIndex];
+
+    // Steps are in build order, so parents always come first
+    AAttachment *Parent = StepInstances.IsValidIndex(Step.ParentStep)
+                              ? StepInstances[Step.ParentStep]
+                              : nullptr;
+    if (Step.ParentStep != INDEX_NONE && !Parent)
+      continue;
+
+    AAttachment *Instance = AcquireAttachment(Step.AttachmentClass);
+    if (!Instance)
+      continue;
+
+    Instance->LoadAttachmentInfo();
+    USkeletalMeshComponent *Mesh = Instance->MeshComponent;
+
+    if (!Parent) {
+      // Root: sits directly on the weapon
+      if (Weapon && Weapon->GetRoot() && Mesh) {
+        Mesh->AttachToComponent(
+            Weapon->GetRoot(),
+            FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+        Mesh->SetRelativeTransform(Step.RelativeTransform);
+      }
+    } else {
+      ARailAttachment *Rail = Step.RailSlot != INDEX_NONE
+                                  ? Cast<ARailAttachment>(Parent)
+                                  : nullptr;
+      if (Rail) {
+        // Recorded slot, re-checked against this world's overlap state
+        if (!ReplayRailSlot(Rail, Instance, Step)) {
+          TRACE_ATTACHMENT_ATTACH(this, Instance, Rail, -1, false);
+          ReleaseAttachment(Instance);
+          continue;
+        }
+      } else if (Parent->MeshComponent && Mesh) {
+        Mesh->AttachToComponent(
+            Parent->MeshComponent,
+            FAttachmentTransformRules::SnapToTargetNotIncludingScale,
+            Step.Socket);
+        Mesh->SetRelativeTransform(Step.RelativeTransform);
+      }
+
+      if (Parent->ChildrenLinks.IsValidIndex(Step.LinkIndex)) {
+        Parent->ChildrenLinks[Step.LinkIndex].ChildInstances.Add(Instance);
+      }
+    }
+
+    StepInstances[StepIndex] = Instance;
+    RegisterAttachment(Instance, Mesh);
+  }
+
+  UE_LOG(LogAttachmentSystem, Log,
+         TEXT("Replayed build plan for %s (%d steps, %d attachments)"),
+         *GetOwner()->GetName(), Plan.Steps.Num(), SpawnedAttachments.Num());
+}
+
+bool UWeaponBuilderComponent::ReplayRailSlot(ARailAttachment *Rail,
+                                             AAttachment *Instance,
+                                             const FWeaponBuildStep &Step) {
+  USkeletalMeshComponent *ParentMesh = Rail->MeshComponent;
+  USkeletalMeshComponent *Mesh = Instance->MeshComponent;
+  if (!ParentMesh || !Mesh)
+    return false;
+
+  const int32 Slot = Step.RailSlot;
+  const bool bSlotFree =
+      Slot >= 0 && Slot < ARailAttachment::MaxSlots &&
+      (Rail->GetFreeStartSlotMask(Instance->Size) & (1ull << Slot)) != 0ull;
+
+  if (bSlotFree) {
+    // Same test the solver ran, for the recorded slot only, at the world
+    // location the recorded transform puts the part on the socket
+    const FTransform RecordedWorld =
+        Step.RelativeTransform * ParentMesh->GetSocketTransform(Step.Socket);
+    TArray<FTransform, TInlineAllocator<ARailAttachment::MaxSlots>>
+        SlotTransforms;
+    SlotTransforms.SetNum(Slot + 1);
+    SlotTransforms[Slot].SetLocation(RecordedWorld.GetLocation());
+
+    int32 Probes = 0;
+    const uint64 FreeSlots = FilterCollisionFreeSlots(
+        1ull << Slot, SlotTransforms, Mesh, Rail, Probes);
+    RailPlacementStats.PhysicsProbes += Probes;
+
+    if (FreeSlots != 0ull) {
+      // Same order as PlaceOnRail: PlaceAttachment re-parents to the rail,
+      // then the socket attach and recorded transform give the final pose
+      Instance->StartPosition = Slot;
+      Rail->PlaceAttachment(Instance);
+      Mesh->AttachToComponent(
+          ParentMesh, FAttachmentTransformRules::SnapToTargetNotIncludingScale,
+          Step.Socket);
+      Mesh->SetRelativeTransform(Step.RelativeTransform);
+      TRACE_ATTACHMENT_ATTACH(this, Instance, Rail, Slot, true);
+      return true;
+    }
+  }
+
+  // Slot taken or blocked in this world: solve it again
+  UE_LOG(LogAttachmentSystem, Verbose,
+         TEXT("Recorded rail slot %d for %s is not free, re-solving"), Slot,
+         *Instance->GetName());
+  return PlaceOnRail(Rail, Instance, Step.Socket);
+}
+
+void UWeaponBuilderComponent::CompactAttachments() {
+  const int32 NumParts = SpawnedAttachments.Num();
+
+  TMap<AAttachment *, int32> IndexByAttachment;
+  IndexByAttachment.Reserve(NumParts);
+  for (int32 i = 0; i < NumParts; ++i) {
+    IndexByAttachment.Add(SpawnedAttachments[i], i);
+  }
+
+  // Parent index per part, from the links (roots keep INDEX_NONE)
+  TArray<int32, TInlineAllocator<32>> ParentIndex;
+  ParentIndex.Init(INDEX_NONE, NumParts);
+  for (int32 i = 0; i < NumParts; ++i) {
+    for (const FAttachmentLink &Link : SpawnedAttachments[i]->ChildrenLinks) {
+      for (AAttachment *Child : Link.ChildInstances) {
+        if (const int32 *ChildIndex = IndexByAttachment.Find(Child)) {
+          ParentIndex[*ChildIndex] = i;
+        }
+      }
+    }
+  }
+
+  // A part can go mesh-only if it and its whole subtree can. Registration
+  // is BFS order, so walking backwards sees children before parents.
+  TBitArray<> bCompactable(true, NumParts);
+  for (int32 i = NumParts - 1; i >= 0; --i) {
+    const AAttachment *Attachment = SpawnedAttachments[i];
+    if (Attachment->RequiresActor() || !Attachment->MeshComponent) {
+      bCompactable[i] = false;
+    }
+    if (!bCompactable[i] && ParentIndex[i] != INDEX_NONE) {
+      bCompactable[ParentIndex[i]] = false;
+    }
+  }
+
+  // Child parts attach to skeletal sockets, so only leaves go static
+  TBitArray<> bHasCompactChild(false, NumParts);
+  for (int32 i = 0; i < NumParts; ++i) {
+    if (bCompactable[i] && ParentIndex[i] != INDEX_NONE) {
+      bHasCompactChild[ParentIndex[i]] = true;
+    }
+  }
+
+  TArray<int32, TInlineAllocator<32>> PartByAttachment;
+  PartByAttachment.Init(INDEX_NONE, NumParts);
+
+  for (int32 i = 0; i < NumParts; ++i) {
+    if (!bCompactable[i])
+      continue;
+
+    AAttachment *Attachment = SpawnedAttachments[i];
+    USkeletalMeshComponent *Mesh = Attachment->MeshComponent;
+
+    FCompactAttachmentPart &Part = CompactParts.AddDefaulted_GetRef();
+    Part.Mesh = Mesh->GetSkeletalMeshAsset();
+    Part.Category = Attachment->GetAttachmentCategory();
+    if (!bHasCompactChild[i] && Attachment->IsRenderedAsStatic()) {
+      Part.StaticMesh = Attachment->StaticMeshComponent->GetStaticMesh();
+    }
+    Part.Socket = Mesh->GetAttachSocketName();
+    Part.RelativeTransform = Mesh->GetRelativeTransform();
+
+    const int32 Parent = ParentIndex[i];
+    if (Parent == INDEX_NONE) {
+      Part.bOnWeaponRoot = true;
+    } else if (PartByAttachment[Parent] != INDEX_NONE) {
+      Part.ParentPart = PartByAttachment[Parent];
+    } else {
+      Part.ParentActor = SpawnedAttachments[Parent];
+    }
+    PartByAttachment[i] = CompactParts.Num() - 1;
+
+    // Data holder only: no channel, no tick, nothing drawn
+    Attachment->SetActorHiddenInGame(true);
+    Attachment->SetActorEnableCollision(false);
+    Attachment->SetActorTickEnabled(false);
+    Attachment->SetReplicates(false);
+    CompactedAttachments.Add(Attachment);
+  }
+
+  CreateCompactMeshes();
+
+  UE_LOG(LogAttachmentSystem, Log,
+         TEXT("Compact build for %s: %d of %d parts are mesh-only"),
+         *GetOwner()->GetName(), CompactParts.Num(), NumParts);
+}
+
+void UWeaponBuilderComponent::RestoreCompactedAttachments() {
+  for (AAttachment *Attachment : CompactedAttachments) {
+    if (!IsValid(Attachment))
+      continue;
+
+    const AActor *Defaults = Attachment->GetClass()->GetDefaultObject<AActor>();
+    Attachment->SetReplicates(Defaults->GetIsReplicated());
+    Attachment->SetActorTickEnabled(
+        Defaults->PrimaryActorTick.bStartWithTickEnabled);
+    Attachment->SetActorHiddenInGame(false);
+    Attachment->SetActorEnableCollision(true);
+  }
+  CompactedAttachments.Reset();
+}
+
+void UWeaponBuilderComponent::CreateCompactMeshes() {
+  AActor *Owner = GetOwner();
+  if (!Owner)
+    return;
+
+  USceneComponent *WeaponRoot =
+      Weapon ? Weapon->GetRoot() : Owner->GetRootComponent();
+
+  CompactMeshes.Reserve(CompactParts.Num());
+  for (const FCompactAttachmentPart &Part : CompactParts) {
+    USceneComponent *Parent = nullptr;
+    if (Part.bOnWeaponRoot) {
+      Parent = WeaponRoot;
+    } else if (CompactMeshes.IsValidIndex(Part.ParentPart)) {
+      Parent = CompactMeshes[Part.ParentPart];
+    } else if (Part.ParentActor) {
+      Parent = Part.ParentActor->MeshComponent;
+    }
+
+    // Parent actor not replicated yet: OnRep fires again once it maps
+    if (!Parent || (!Part.Mesh && !Part.StaticMesh)) {
+      CompactMeshes.Add(nullptr);
+      continue;
+    }
+
+    UMeshComponent *Mesh = nullptr;
+    if (Part.StaticMesh) {
+      UStaticMeshComponent *Static = NewObject<UStaticMeshComponent>(Owner);
+      Static->SetStaticMesh(Part.StaticMesh);
+      Mesh = Static;
+    } else {
+      USkeletalMeshComponent *Skeletal =
+          NewObject<USkeletalMeshComponent>(Owner);
+      Skeletal->SetSkeletalMeshAsset(Part.Mesh);
+      Mesh = Skeletal;
+    }
+    Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Mesh->SetComponentTickEnabled(false);
+    Mesh->RegisterComponent();
+    Mesh->AttachToComponent(
+        Parent, FAttachmentTransformRules::SnapToTargetNotIncludingScale,
+        Part.Socket);
+    Mesh->SetRelativeTransform(Part.RelativeTransform);
+    Mesh->SetHiddenInGame(bSmallPartsHidden &&
+                          SmallPartCategories.Contains(Part.Category));
+    CompactMeshes.Add(Mesh);
+  }
+}
+
+void UWeaponBuilderComponent::DestroyCompactMeshes() {
+  for (UMeshComponent *Mesh : CompactMeshes) {
+    if (IsValid(Mesh)) {
+      Mesh->DestroyComponent();
+    }
+  }
+  CompactMeshes.Reset();
+}
+
+void UWeaponBuilderComponent::OnRep_CompactParts() {
+  DiscardBakedMesh();
+  DestroyCompactMeshes();
+  CreateCompactMeshes();
+  RequestRebake();
+}
+
+void UWeaponBuilderComponent::RequestRebake() {
+  UWorld *World = GetWorld();
+  // Nothing is drawn on a dedicated server
+  if (!bBakeMergedMesh || !World || World->GetNetMode() == NM_DedicatedServer)
+    return;
+
+  FTimerManager &TimerManager = World->GetTimerManager();
+  if (TimerManager.IsTimerPending(RebakeHandle) ||
+      TimerManager.IsTimerActive(RebakeHandle))
+    return;
+
+  RebakeHandle =
+      TimerManager.SetTimerForNextTick(this, &ThisClass::BakeMergedMesh);
+}
+
+void UWeaponBuilderComponent::BakeMergedMesh() {
+  AActor *Owner = GetOwner();
+  USceneComponent *WeaponRoot =
+      Weapon ? Weapon->GetRoot() : (Owner ? Owner->GetRootComponent() : nullptr);
+  if (!WeaponRoot)
+    return;
+
+  // Sources of the previous bake must be visible to be gathered again
+  DiscardBakedMesh();
+
+  TArray<USceneComponent *> Children;
+  WeaponRoot->GetChildrenComponents(/*bIncludeAllDescendants=*/true, Children);
+
+  TArray<UStaticMeshComponent *> Sources;
+  for (USceneComponent *Child : Children) {
+    UStaticMeshComponent *Static = Cast<UStaticMeshComponent>(Child);
+    if (!Static || Static == BakedMeshComponent || !Static->GetStaticMesh() ||
+        !Static->IsVisible())
+      continue;
+    if (const AActor *PartOwner = Static->GetOwner();
+        PartOwner && PartOwner->IsHidden())
+      continue;
+    Sources.Add(Static);
+  }
+
+  TArray<UStaticMeshComponent *> Merged;
+  UStaticMesh *MergedMesh =
+      Sources.Num() > 0
+          ? WeaponMeshBaker::BakeStaticMeshes(
+                this, Sources, WeaponRoot->GetComponentTransform(), Merged)
+          : nullptr;
+
+  if (!BakedMeshComponent && MergedMesh) {
+    BakedMeshComponent = NewObject<UStaticMeshComponent>(Owner);
+    BakedMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    BakedMeshComponent->RegisterComponent();
+    BakedMeshComponent->AttachToComponent(
+        WeaponRoot, FAttachmentTransformRules::SnapToTargetIncludingScale);
+  }
+  if (BakedMeshComponent) {
+    BakedMeshComponent->SetStaticMesh(MergedMesh);
+  }
+
+  BakedSources = Merged;
+  ApplyBakedView();
+
+  UE_LOG(LogAttachmentSystem, Log,
+         TEXT("Baked %d of %d static parts of %s into one mesh"),
+         Merged.Num(), Sources.Num(), *Owner->GetName());
+}
+
+void UWeaponBuilderComponent::SetSmallPartsHidden(const bool bHidden) {
+  bSmallPartsHidden = bHidden;
+
+  AActor *Owner = GetOwner();
+  if (!Owner)
+    return;
+
+  // Attachment actors hang off the weapon on every machine
+  TArray<AActor *> Attached;
+  Owner->GetAttachedActors(Attached, /*bResetArray=*/true,
+                           /*bRecursivelyIncludeAttachedActors=*/true);
+  for (AActor *Actor : Attached) {
+    AAttachment *Attachment = Cast<AAttachment>(Actor);
+    if (!Attachment ||
+        !SmallPartCategories.Contains(Attachment->GetAttachmentCategory()))
+      continue;
+
+    if (Attachment->MeshComponent) {
+      Attachment->MeshComponent->SetHiddenInGame(bHidden);
+    }
+    if (Attachment->StaticMeshComponent) {
+      Attachment->StaticMeshComponent->SetHiddenInGame(bHidden);
+    }
+  }
+
+  for (int32 i = 0; i < CompactMeshes.Num(); ++i) {
+    if (CompactMeshes[i] && CompactParts.IsValidIndex(i) &&
+        SmallPartCategories.Contains(CompactParts[i].Category)) {
+      CompactMeshes[i]->SetHiddenInGame(bHidden);
+    }
+  }
+}
+
+void UWeaponBuilderComponent::SetBakedViewEnabled(const bool bEnabled) {
+  bBakedViewEnabled = bEnabled;
+  ApplyBakedView();
+}
+
+void UWeaponBuilderComponent::ApplyBakedView() {
+  const bool bShowBaked = bBakedViewEnabled && BakedMeshComponent &&
+                          BakedMeshComponent->GetStaticMesh();
+
+  if (BakedMeshComponent) {
+    BakedMeshComponent->SetVisibility(bShowBaked);
+  }
+  for (UStaticMeshComponent *Source : BakedSources) {
+    if (IsValid(Source)) {
+      Source->SetVisibility(!bShowBaked);
+    }
+  }
+}
+
+void UWeaponBuilderComponent::DiscardBakedMesh() {
+  for (UStaticMeshComponent *Source : BakedSources) {
+    if (IsValid(Source)) {
+      Source->SetVisibility(true);
+    }
+  }
+  BakedSources.Reset();
+
+  if (BakedMeshComponent) {
+    BakedMeshComponent->SetStaticMesh(nullptr);
+    BakedMeshComponent->SetVisibility(false);
+  }
+}
+
+FWeaponBuildFootprint UWeaponBuilderComponent::GetBuildFootprint() const {
+  FWeaponBuildFootprint Footprint;
+
+  auto CountMesh = [&Footprint](const UMeshComponent *Mesh) {
+    if (!Mesh || !Mesh->IsVisible())
+      return;
+    if (const USkeletalMeshComponent *Skeletal =
+            Cast<USkeletalMeshComponent>(Mesh)) {
+      if (!Skeletal->GetSkeletalMeshAsset())
+        return;
+    } else if (const UStaticMeshComponent *Static =
+                   Cast<UStaticMeshComponent>(Mesh)) {
+      if (!Static->GetStaticMesh())
+        return;
+      ++Footprint.StaticMeshComponents;
+    }
+    ++Footprint.MeshComponents;
+    Footprint.DrawSections += Mesh->GetNumMaterials();
+    if (Mesh->IsComponentTickEnabled()) {
+      ++Footprint.TickFunctions;
+    }
+  };
+
+  for (const AAttachment *Attachment : SpawnedAttachments) {
+    if (!Attachment)
+      continue;
+    if (Attachment->GetIsReplicated()) {
+      ++Footprint.ReplicatedActors;
+    }
+    if (Attachment->IsActorTickEnabled()) {
+      ++Footprint.TickFunctions;
+    }
+    if (!Attachment->IsHidden()) {
+      CountMesh(Attachment->MeshComponent);
+      CountMesh(Attachment->StaticMeshComponent);
+    }
+  }
+
+  for (const UMeshComponent *Mesh : CompactMeshes) {
+    CountMesh(Mesh);
+  }
+  CountMesh(BakedMeshComponent);
+
+  return Footprint;
+}
+
+void UWeaponBuilderComponent::RunCompactBuildReport() {
+  if (!GetOwner() || !GetOwner()->HasAuthority() ||
+      SpawnedAttachments.Num() == 0) {
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Compact Build Report: build the weapon on the server first"));
+    return;
+  }
+
+  // Both sides are real builds of this weapon. Its meshes are resident
+  // after the first build, so each rebuild completes in place.
+  const bool bWasCompact = bCompactBuild;
+  FWeaponBuildFootprint Footprints[2];
+  double BuildMs[2] = {0.0, 0.0};
+  int32 NumParts = 0;
+  int32 NumMeshOnly = 0;
+
+  for (int32 Mode = 0; Mode < 2; ++Mode) {
+    bCompactBuild = Mode == 1;
+
+    const double Start = FPlatformTime::Seconds();
+    BuildWeapon();
+    BuildMs[Mode] = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+    if (IsBuildPending()) {
+      UE_LOG(LogAttachmentSystem, Warning,
+             TEXT("Compact Build Report: meshes still streaming, try again"));
+      bCompactBuild = bWasCompact;
+      return;
+    }
+
+    Footprints[Mode] = GetBuildFootprint();
+    NumParts = SpawnedAttachments.Num();
+    NumMeshOnly = CompactParts.Num();
+  }
+
+  // Leave the weapon the way it was configured
+  bCompactBuild = bWasCompact;
+  if (!bWasCompact) {
+    BuildWeapon();
+  }
+
+  UE_LOG(LogAttachmentSystem, Warning,
+         TEXT("Compact Build Report: %s, %d parts, %d mesh-only"),
+         *GetOwner()->GetName(), NumParts, NumMeshOnly);
+  const TCHAR *ModeNames[2] = {TEXT("Actor per part"), TEXT("Compact")};
+  for (int32 Mode = 0; Mode < 2; ++Mode) {
+    const FWeaponBuildFootprint &Footprint = Footprints[Mode];
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("%s → %d replicated actors | %d tick functions | "
+                "%d mesh components (%d static) | %d draw sections | "
+                "build %.3f ms"),
+           ModeNames[Mode], Footprint.ReplicatedActors,
+           Footprint.TickFunctions, Footprint.MeshComponents,
+           Footprint.StaticMeshComponents, Footprint.DrawSections,
+           BuildMs[Mode]);
+  }
+}
+
 void UWeaponBuilderComponent::Server_BuildWeapon_Implementation() {
   if (!GetOwner() || !GetOwner()->HasAuthority())
     return;
@@ -280,12 +922,145 @@ void UWeaponBuilderComponent::Server_BuildWeapon_Implementation() {
   BuildWeapon();
 }
 
+bool UWeaponBuilderComponent::PlaceOnRail(ARailAttachment *Rail,
+                                          AAttachment *ChildInstance,
+                                          const FName TargetSocket) {
+  USkeletalMeshComponent *ParentMesh = Rail->MeshComponent;
+  USkeletalMeshComponent *ChildMesh = ChildInstance->MeshComponent;
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_RailSweep);
+
+  if (!ParentMesh || !ChildMesh || !Rail->RailSpline ||
+      !ParentMesh->DoesSocketExist(TargetSocket))
+    return false;
+
+  ++RailPlacementStats.Placements;
+
+  // Every start slot where the child fits, resolved in O(Size) word ops
+  const int32 UsableSlots =
+      FMath::Min(Rail->NumSlots, ARailAttachment::MaxSlots);
+  uint64 Candidates = Rail->GetFreeStartSlotMask(ChildInstance->Size);
+
+  const float SocketZ = ParentMesh->GetSocketLocation(TargetSocket).Z;
+
+  // Candidate transforms, indexed by slot
+  TArray<FTransform, TInlineAllocator<ARailAttachment::MaxSlots>>
+      SlotTransforms;
+  SlotTransforms.SetNum(UsableSlots);
+  for (uint64 Remaining = Candidates; Remaining != 0ull;
+       Remaining &= Remaining - 1ull) {
+    const int32 Slot =
+        static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+
+    FVector SplineLoc = Rail->RailSpline->GetLocationAtDistanceAlongSpline(
+        Rail->GetDistanceFromSlot(Slot), ESplineCoordinateSpace::World);
+
+    // Force Z from socket
+    SplineLoc.Z = SocketZ;
+    SlotTransforms[Slot].SetLocation(SplineLoc);
+  }
+
+  int32 Probes = 0;
+  const uint64 FreeSlots = FilterCollisionFreeSlots(
+      Candidates, SlotTransforms, ChildMesh, Rail, Probes);
+  RailPlacementStats.PhysicsProbes += Probes;
+
+  if (FreeSlots == 0ull) {
+    RailPlacementStats.ProbesSkipped += UsableSlots - Probes;
+    return false;
+  }
+
+  const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(FreeSlots));
+  const FVector SlotLoc = SlotTransforms[Slot].GetLocation();
+
+  ChildInstance->StartPosition = Slot;
+  Rail->PlaceAttachment(ChildInstance);
+
+  ChildMesh->AttachToComponent(
+      ParentMesh, FAttachmentTransformRules::SnapToTargetNotIncludingScale,
+      TargetSocket);
+  ChildMesh->SetWorldLocation(SlotLoc);
+
+  // A linear scan would have probed every slot up to and including this one
+  RailPlacementStats.ProbesSkipped += (Slot + 1) - Probes;
+
+  TRACE_ATTACHMENT_ATTACH(this, ChildInstance, Rail, Slot, true);
+  UE_LOG(LogAttachmentSystem, Verbose,
+         TEXT("Attached %s at slot %d on rail %s | Z=%.2f"),
+         *ChildInstance->GetName(), Slot, *Rail->GetName(), SocketZ);
+  return true;
+}
+
+uint64 UWeaponBuilderComponent::FilterCollisionFreeSlots(
+    uint64 CandidateSlots, const TConstArrayView<FTransform> SlotTransforms,
+    USkeletalMeshComponent *ChildMesh, ARailAttachment *Rail,
+    int32 &OutPhysicsProbes, const bool bStopAtFirstFree) {
+  OutPhysicsProbes = 0;
+  if (!ChildMesh || !Rail)
+    return 0ull;
+
+  // Never read past the supplied transforms
+  if (SlotTransforms.Num() < ARailAttachment::MaxSlots)
+    CandidateSlots &= (1ull << SlotTransforms.Num()) - 1ull;
+
+  // Broadphase: cached world bounds of every part of this weapon (on any
+  // rail or socket), except the rail itself and the candidate
+  TArray<FBox, TInlineAllocator<32>> PartBounds;
+  PartBounds.Reserve(SpawnedAttachments.Num());
+  for (const AAttachment *Part : SpawnedAttachments) {
+    if (!Part || Part == Rail || !Part->MeshComponent ||
+        Part->MeshComponent == ChildMesh)
+      continue;
+    PartBounds.Add(Part->MeshComponent->Bounds.GetBox());
+  }
+
+  // Same inflated extents as the physics query
+  const FBox LocalBox(-ChildMesh->Bounds.BoxExtent * 1.2f,
+                      ChildMesh->Bounds.BoxExtent * 1.2f);
+
+  // Broadphase only rejects early: a slot touching a part's AABB is taken,
+  // every other slot still goes to the physics scene, which also sees world
+  // geometry and anything that is not a part of this weapon
+  uint64 FreeSlots = 0ull;
+  for (uint64 Remaining = CandidateSlots; Remaining != 0ull;
+       Remaining &= Remaining - 1ull) {
+    const int32 Slot =
+        static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+    const FBox CandidateBox = LocalBox.TransformBy(SlotTransforms[Slot]);
+
+    bool bTouchesPart = false;
+    for (const FBox &Bounds : PartBounds) {
+      if (CandidateBox.Intersect(Bounds)) {
+        bTouchesPart = true;
+        break;
+      }
+    }
+    if (bTouchesPart) {
+      ++RailPlacementStats.BroadphaseRejects;
+      continue;
+    }
+
+    // Narrowphase: physics overlap for every slot the bounds let through
+    ++OutPhysicsProbes;
+    if (DoesCollideWithRail(SlotTransforms[Slot], ChildMesh, Rail))
+      continue;
+
+    FreeSlots |= 1ull << Slot;
+    if (bStopAtFirstFree)
+      break;
+  }
+
+  return FreeSlots;
+}
+
 bool UWeaponBuilderComponent::DoesCollideWithRail(
     const FTransform &TestTransform, USkeletalMeshComponent *ChildMesh,
     AActor *IgnoredActor) const {
   if (!ChildMesh)
     return true;
 
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_RailOverlapQuery);
+  INC_DWORD_STAT(STAT_RailOverlapQueries);
+
   // Slightly inflate extents so “almost touching” still counts
   FVector Extents = ChildMesh->Bounds.BoxExtent * 1.2f;
 
@@ -305,27 +1080,27 @@ bool UWeaponBuilderComponent::DoesCollideWithRail(
   const bool bHit = GetWorld()->OverlapMultiByObjectType(
       Overlaps, TestTransform.GetLocation(), TestTransform.GetRotation(),
       ObjParams, FCollisionShape::MakeBox(Extents), QueryParams);
-
-  UE_LOG(LogTemp, Warning,
-         TEXT("Collision test at %s | Overlaps=%d | Result=%d"),
-         *TestTransform.GetLocation().ToString(), Overlaps.Num(), bHit);
+  TRACE_ATTACHMENT_RAIL_PROBE(this, TestTransform.GetLocation(),
+                              Overlaps.Num(), bHit);
 
 #if WITH_EDITOR
-  // Draw the test box
-  DrawDebugBox(GetWorld(), TestTransform.GetLocation(), Extents,
-               TestTransform.GetRotation(), bHit ? FColor::Red : FColor::Green,
-               false, 5.f);
-#endif
-
-  // Print who we overlapped
-  if (bHit) {
+  // Draw the test box and print who we overlapped (opt-in, very noisy)
+  if (bDebugRailQueries) {
+    DrawDebugBox(GetWorld(), TestTransform.GetLocation(), Extents,
+                 TestTransform.GetRotation(),
+                 bHit ? FColor::Red : FColor::Green, false, 5.f);
+
+    UE_LOG(LogAttachmentSystem, Log,
+           TEXT("Collision test at %s | Overlaps=%d | Result=%d"),
+           *TestTransform.GetLocation().ToString(), Overlaps.Num(), bHit);
     for (const FOverlapResult &Res : Overlaps) {
       if (const AActor *HitActor = Res.GetActor()) {
-        UE_LOG(LogTemp, Warning, TEXT("  -> overlap: %s"),
+        UE_LOG(LogAttachmentSystem, Log, TEXT("  -> overlap: %s"),
                *HitActor->GetName());
       }
     }
   }
+#endif
 
   return bHit;
 }
@@ -345,13 +1120,7 @@ void UWeaponBuilderComponent::BuildWeaponFromAttachmentGraph(
         continue;
 
       // Always spawn a new instance (multiple children of same class allowed)
-      FActorSpawnParameters SpawnParams;
-      SpawnParams.Owner = GetOwner();
-      SpawnParams.SpawnCollisionHandlingOverride =
-          ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-      AAttachment *ChildInstance = GetWorld()->SpawnActor<AAttachment>(
-          ChildClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+      AAttachment *ChildInstance = AcquireAttachment(ChildClass);
 
       if (!ChildInstance)
         continue;
@@ -380,8 +1149,7 @@ void UWeaponBuilderComponent::BuildWeaponFromAttachmentGraph(
       Link.ChildInstances.Add(ChildInstance);
 
       // Register globally
-      SpawnedAttachments.Add(ChildInstance);
-      SpawnedMeshes.Add(ChildInstance, ChildMesh);
+      RegisterAttachment(ChildInstance, ChildMesh);
     }
   }
 }
@@ -393,6 +1161,20 @@ void UWeaponBuilderComponent::ClearWeapon() {
     return;
   }
 
+  CancelPendingBuild();
+
+  // Listeners (the weapon's stats, durability, magazine/barrel) drop the
+  // parts before they go back to the pool and are reset
+  if (SpawnedAttachments.Num() > 0) {
+    OnWeaponCleared.Broadcast();
+  }
+
+  // Pooled actors must come back awake
+  DiscardBakedMesh();
+  RestoreCompactedAttachments();
+  DestroyCompactMeshes();
+  CompactParts.Reset();
+
   TSet<AAttachment *> Visited;
   for (AAttachment *Root : SpawnedAttachments) {
     ClearAttachmentRecursive(Root, Visited);
@@ -405,8 +1187,29 @@ void UWeaponBuilderComponent::ClearWeapon() {
     }
   }
 
+  // Behaviours of a cleared weapon stop ticking
+  if (UAttachmentTickSubsystem *TickSubsystem =
+          GetWorld() ? GetWorld()->GetSubsystem<UAttachmentTickSubsystem>()
+                     : nullptr) {
+    for (const TPair<AAttachment *, UActorComponent *> &Pair :
+         SpawnedBehaviors) {
+      TickSubsystem->UnregisterAllTicks(Pair.Value);
+    }
+  }
+
+  // Pooled parts come back without the behaviour of their last weapon
+  for (const TPair<AAttachment *, UActorComponent *> &Pair : SpawnedBehaviors) {
+    if (IsValid(Pair.Value)) {
+      Pair.Value->DestroyComponent();
+    }
+  }
+  SpawnedBehaviors.Empty();
+
   SpawnedAttachments.Empty();
   SpawnedMeshes.Empty();
+  for (FAttachmentCategoryBucket &Bucket : CategoryIndex) {
+    Bucket.Attachments.Reset();
+  }
 }
 
 void UWeaponBuilderComponent::Server_ClearWeapon_Implementation() {
@@ -416,6 +1219,43 @@ void UWeaponBuilderComponent::Server_ClearWeapon_Implementation() {
   ClearWeapon();
 }
 
+AAttachment *UWeaponBuilderComponent::AcquireAttachment(
+    const TSubclassOf<AAttachment> AttachmentClass) const {
+  UWorld *World = GetWorld();
+  if (!*AttachmentClass || !World)
+    return nullptr;
+
+  ATTACHMENT_SCOPE_CYCLE_COUNTER(STAT_SpawnAttachment);
+  INC_DWORD_STAT(STAT_AttachmentsAcquired);
+
+  if (UAttachmentPoolSubsystem *Pool =
+          World->GetSubsystem<UAttachmentPoolSubsystem>()) {
+    return Pool->Acquire(AttachmentClass, GetOwner());
+  }
+
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.Owner = GetOwner();
+  SpawnParams.SpawnCollisionHandlingOverride =
+      ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+  return World->SpawnActor<AAttachment>(AttachmentClass, FVector::ZeroVector,
+                                        FRotator::ZeroRotator, SpawnParams);
+}
+
+void UWeaponBuilderComponent::ReleaseAttachment(
+    AAttachment *Attachment) const {
+  if (!IsValid(Attachment))
+    return;
+
+  UWorld *World = GetWorld();
+  if (UAttachmentPoolSubsystem *Pool =
+          World ? World->GetSubsystem<UAttachmentPoolSubsystem>() : nullptr) {
+    Pool->Release(Attachment);
+  } else {
+    Attachment->Destroy();
+  }
+}
+
 void UWeaponBuilderComponent::ClearAttachmentRecursive(
     AAttachment *Attachment, TSet<AAttachment *> &Visited) {
   if (!Attachment || Visited.Contains(Attachment))
@@ -436,62 +1276,158 @@ void UWeaponBuilderComponent::ClearAttachmentRecursive(
     Attachment->MeshComponent->DetachFromComponent(
         FDetachmentTransformRules::KeepWorldTransform);
   }
+
+  // Children are cleared first, so the links can be reset safely
+  ReleaseAttachment(Attachment);
 }
 
 AAttachment *UWeaponBuilderComponent::GetAttachmentAtSocket(
     const EAttachmentCategory Category) {
-  TSet<AAttachment *> Visited;
+  const int32 Index = static_cast<int32>(Category);
+  if (!CategoryIndex.IsValidIndex(Index))
+    return nullptr;
+
+  // Registration order is BFS order, so the first entry is the shallowest
+  const TArray<TObjectPtr<AAttachment>> &Bucket =
+      CategoryIndex[Index].Attachments;
+  return Bucket.Num() > 0 ? Bucket[0].Get() : nullptr;
+}
+
+TArray<AAttachment *> UWeaponBuilderComponent::GetAttachmentsInCategory(
+    const EAttachmentCategory Category) const {
+  const int32 Index = static_cast<int32>(Category);
+  if (!CategoryIndex.IsValidIndex(Index))
+    return TArray<AAttachment *>();
+
+  return TArray<AAttachment *>(CategoryIndex[Index].Attachments);
+}
+
+void UWeaponBuilderComponent::RegisterAttachment(AAttachment *Attachment,
+                                                 USceneComponent *Mesh) {
+  SpawnedAttachments.Add(Attachment);
+  SpawnedMeshes.Add(Attachment, Mesh);
+
+  if (CategoryIndex.Num() != NumAttachmentCategories) {
+    CategoryIndex.SetNum(NumAttachmentCategories);
+  }
 
-  for (AAttachment *Attachment : SpawnedAttachments) {
-    AAttachment *Found = FindAttachmentRecursive(Attachment, Category, Visited);
-    if (Found)
-      return Found;
+  const int32 Index = static_cast<int32>(Attachment->GetAttachmentCategory());
+  if (CategoryIndex.IsValidIndex(Index)) {
+    CategoryIndex[Index].Attachments.Add(Attachment);
   }
 
-  return nullptr;
+  AddBehaviorComponent(Attachment);
 }
 
-AAttachment *UWeaponBuilderComponent::FindAttachmentRecursive(
-    AAttachment *Attachment, const EAttachmentCategory TargetCategory,
-    TSet<AAttachment *> &Visited) {
-  if (!Attachment || Visited.Contains(Attachment))
-    return nullptr;
-  Visited.Add(Attachment);
+FName UWeaponBuilderComponent::GetSocketFromCategory(
+    EAttachmentCategory Category) const {
+  // Callers outside a build (before BeginPlay, editor tools) resolve here
+  if (!bSocketTableResolved) {
+    ResolveSocketTable();
+  }
+
+  const int32 Index = static_cast<int32>(Category);
+  return Index < NumAttachmentCategories ? ResolvedSockets[Index] : NAME_None;
+}
 
-  // Check if the current attachment's category matches the target
-  if (Attachment->GetAttachmentInfo().Category == TargetCategory) {
-    return Attachment;
+void UWeaponBuilderComponent::RefreshSocketTable() { ResolveSocketTable(); }
+
+void UWeaponBuilderComponent::ResolveSocketTable() const {
+  bSocketTableResolved = true;
+  for (int32 i = 0; i < NumAttachmentCategories; ++i) {
+    ResolvedSockets[i] =
+        AttachmentSockets::GetDefaultSocket(static_cast<EAttachmentCategory>(i));
   }
 
-  // Traverse all children in all links
-  for (const FAttachmentLink &Link : Attachment->ChildrenLinks) {
-    for (AAttachment *Child : Link.ChildInstances) {
-      if (!Child)
-        continue;
+  if (!SocketMapping)
+    return;
 
-      // Check if this child matches the category
-      if (Child->GetAttachmentInfo().Category == TargetCategory) {
-        return Child;
-      }
+  for (const TPair<EAttachmentCategory, FName> &Override :
+       SocketMapping->SocketOverrides) {
+    const int32 Index = static_cast<int32>(Override.Key);
+    if (Index < NumAttachmentCategories) {
+      ResolvedSockets[Index] = Override.Value;
+    }
+  }
+}
 
-      // Recursively search deeper
-      if (AAttachment *Found =
-              FindAttachmentRecursive(Child, TargetCategory, Visited)) {
-        return Found;
-      }
+void UWeaponBuilderComponent::RunSocketLookupBenchmark() {
+  constexpr int32 TestCount = 1'000'000;
+  RefreshSocketTable();
+
+  UE_LOG(LogAttachmentSystem, Warning,
+         TEXT("Socket Lookup Test: %d lookups"), TestCount);
+
+  // Accumulate something so the loops are not optimized away
+  int32 Checksum = 0;
+
+  {
+    const double Start = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < TestCount; i++) {
+      const EAttachmentCategory Category =
+          static_cast<EAttachmentCategory>(i % NumAttachmentCategories);
+      Checksum += AttachmentSockets::GetDefaultSocketFromEnum(Category)
+                      .GetComparisonIndex()
+                      .ToUnstableInt();
     }
+
+    const double End = FPlatformTime::Seconds();
+    const double DurationMs = (End - Start) * 1000.0;
+
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("UEnum string → %.3f ms (%.1f ns/lookup)"), DurationMs,
+           DurationMs * 1e6 / TestCount);
   }
 
-  return nullptr; // Nothing found in this branch
-}
+  {
+    const double Start = FPlatformTime::Seconds();
 
-FName UWeaponBuilderComponent::GetSocketFromCategory(
-    EAttachmentCategory Category) const {
-  const UEnum *EnumPtr = StaticEnum<EAttachmentCategory>();
-  if (!EnumPtr)
-    return NAME_None;
+    for (int32 i = 0; i < TestCount; i++) {
+      const EAttachmentCategory Category =
+          static_cast<EAttachmentCategory>(i % NumAttachmentCategories);
+      Checksum +=
+          GetSocketFromCategory(Category).GetComparisonIndex().ToUnstableInt();
+    }
 
-  return FName(EnumPtr->GetNameStringByValue(static_cast<int64>(Category)));
+    const double End = FPlatformTime::Seconds();
+    const double DurationMs = (End - Start) * 1000.0;
+
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("Socket table → %.3f ms (%.1f ns/lookup)"), DurationMs,
+           DurationMs * 1e6 / TestCount);
+  }
+
+  UE_LOG(LogAttachmentSystem, Verbose, TEXT("Checksum: %d"), Checksum);
 }
 
-void UWeaponBuilderComponent::AddBehaviorComponent(AAttachment *Attachment) {}
\ No newline at end of file
+void UWeaponBuilderComponent::AddBehaviorComponent(AAttachment *Attachment) {
+  if (!Attachment || !Attachment->BehaviorClass ||
+      SpawnedBehaviors.Contains(Attachment))
+    return;
+
+  UAttachmentBehaviorComponent *Behavior =
+      NewObject<UAttachmentBehaviorComponent>(Attachment,
+                                              Attachment->BehaviorClass);
+  Behavior->RegisterComponent();
+  SpawnedBehaviors.Add(Attachment, Behavior);
+
+  if (!Behavior->bTickBehavior)
+    return;
+
+  UAttachmentTickSubsystem *TickSubsystem =
+      GetWorld() ? GetWorld()->GetSubsystem<UAttachmentTickSubsystem>()
+                 : nullptr;
+  if (!TickSubsystem) {
+    UE_LOG(LogAttachmentSystem, Warning,
+           TEXT("No tick subsystem, behavior %s of %s will not tick"),
+           *Behavior->GetName(), *Attachment->GetName());
+    return;
+  }
+
+  TickSubsystem->RegisterTick(
+      Behavior,
+      FAttachmentTickDelegate::CreateUObject(
+          Behavior, &UAttachmentBehaviorComponent::TickBehavior),
+      Behavior->BehaviorTickInterval);
+}
\ No newline at end of file
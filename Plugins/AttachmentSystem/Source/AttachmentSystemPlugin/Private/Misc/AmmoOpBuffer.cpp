@@ -0,0 +1,72 @@
+#include "Misc/AmmoOpBuffer.h"
+
+#include "Misc/PackedRoundSequence.h"
+
+bool FAmmoOp::IsValid() const {
+  if (Op >= EAmmoOpType::Count)
+    return false;
+  if (static_cast<uint8>(BulletType) > FPackedRoundSequence::RoundMask)
+    return false;
+  if (Op == EAmmoOpType::ClearChamber)
+    return true;
+  return Count > 0 && Count <= MaxRoundsPerOp;
+}
+
+bool FAmmoOp::NetSerialize(FArchive &Ar, UPackageMap *Map,
+                           bool &bOutSuccess) {
+  uint8 OpBits = static_cast<uint8>(Op);
+  Ar.SerializeBits(&OpBits, 2);
+
+  uint8 TypeBits = static_cast<uint8>(BulletType);
+  Ar.SerializeBits(&TypeBits, FPackedRoundSequence::BitsPerRound);
+
+  uint32 PackedCount = static_cast<uint32>(FMath::Max(Count, 0));
+  Ar.SerializeIntPacked(PackedCount);
+
+  if (Ar.IsLoading()) {
+    Op = static_cast<EAmmoOpType>(OpBits);
+    BulletType = static_cast<EBulletType>(TypeBits);
+    Count = static_cast<int32>(
+        FMath::Min<uint32>(PackedCount, MAX_int32));
+  }
+
+  bOutSuccess = !Ar.IsError();
+  return true;
+}
+
+void FAmmoOpBuffer::Record(const EAmmoOpType Op, const EBulletType BulletType,
+                           const int32 Count) {
+  if (Count <= 0 && Op != EAmmoOpType::ClearChamber)
+    return;
+  ++NumRecorded;
+
+  // The chamber is rewritten, so queued chamber ops no longer matter
+  if (Op == EAmmoOpType::ClearChamber) {
+    Ops.RemoveAll([](const FAmmoOp &Queued) {
+      return Queued.Op == EAmmoOpType::ClearChamber ||
+             Queued.Op == EAmmoOpType::ChamberRounds;
+    });
+  }
+
+  if (Ops.Num() > 0) {
+    FAmmoOp &Last = Ops.Last();
+    const bool bSameKind =
+        Last.Op == Op && Op != EAmmoOpType::ClearChamber &&
+        (Op == EAmmoOpType::RemoveRounds || Last.BulletType == BulletType);
+    if (bSameKind && Last.Count + Count <= FAmmoOp::MaxRoundsPerOp) {
+      Last.Count += Count;
+      return;
+    }
+  }
+
+  FAmmoOp &NewOp = Ops.AddDefaulted_GetRef();
+  NewOp.Op = Op;
+  NewOp.BulletType = BulletType;
+  NewOp.Count = Op == EAmmoOpType::ClearChamber ? 0 : Count;
+}
+
+void FAmmoOpBuffer::Flush(TArray<FAmmoOp> &OutOps) {
+  const int32 ToSend = FMath::Min(Ops.Num(), FAmmoOp::MaxOpsPerFlush);
+  OutOps.Append(Ops.GetData(), ToSend);
+  Ops.RemoveAt(0, ToSend, EAllowShrinking::No);
+}
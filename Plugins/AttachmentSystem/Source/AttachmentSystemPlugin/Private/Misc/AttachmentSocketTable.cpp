@@ -0,0 +1,42 @@
+#include "Misc/AttachmentSocketTable.h"
+
+namespace {
+FName DefaultSockets[NumAttachmentCategories];
+bool bSocketsInitialized = false;
+} // namespace
+
+void AttachmentSockets::Initialize() {
+  // Names come from reflection, so reordering or renaming a category can
+  // never shift sockets onto the wrong entry
+  const UEnum *EnumPtr = StaticEnum<EAttachmentCategory>();
+  if (!EnumPtr)
+    return;
+
+  for (int32 EnumIndex = 0; EnumIndex < EnumPtr->NumEnums(); ++EnumIndex) {
+    const int64 Value = EnumPtr->GetValueByIndex(EnumIndex);
+    if (Value < 0 || Value >= NumAttachmentCategories)
+      continue; // _MAX
+
+    DefaultSockets[Value] = FName(EnumPtr->GetNameStringByIndex(EnumIndex));
+  }
+  bSocketsInitialized = true;
+}
+
+FName AttachmentSockets::GetDefaultSocket(const EAttachmentCategory Category) {
+  // Fallback for lookups before module startup (e.g. CDO construction)
+  if (!bSocketsInitialized) {
+    Initialize();
+  }
+
+  const int32 Index = static_cast<int32>(Category);
+  return Index < NumAttachmentCategories ? DefaultSockets[Index] : NAME_None;
+}
+
+FName AttachmentSockets::GetDefaultSocketFromEnum(
+    const EAttachmentCategory Category) {
+  const UEnum *EnumPtr = StaticEnum<EAttachmentCategory>();
+  if (!EnumPtr)
+    return NAME_None;
+
+  return FName(EnumPtr->GetNameStringByValue(static_cast<int64>(Category)));
+}
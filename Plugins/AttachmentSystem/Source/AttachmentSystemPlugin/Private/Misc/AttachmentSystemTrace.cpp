@@ -0,0 +1,97 @@
+#include "Misc/AttachmentSystemTrace.h"
+
+#if ATTACHMENT_SYSTEM_TRACE_ENABLED
+
+#include "HAL/PlatformTime.h"
+
+UE_TRACE_CHANNEL_DEFINE(AttachmentSystemChannel);
+
+UE_TRACE_EVENT_BEGIN(AttachmentSystem, Ammo)
+  UE_TRACE_EVENT_FIELD(uint64, Cycle)
+  UE_TRACE_EVENT_FIELD(uint32, Owner)
+  UE_TRACE_EVENT_FIELD(uint8, Op)
+  UE_TRACE_EVENT_FIELD(uint8, BulletType)
+  UE_TRACE_EVENT_FIELD(int32, Count)
+  UE_TRACE_EVENT_FIELD(int32, Remaining)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AttachmentSystem, Fire)
+  UE_TRACE_EVENT_FIELD(uint64, Cycle)
+  UE_TRACE_EVENT_FIELD(uint32, Weapon)
+  UE_TRACE_EVENT_FIELD(int32, Shots)
+  UE_TRACE_EVENT_FIELD(int32, Rounds)
+  UE_TRACE_EVENT_FIELD(uint8, FirstRound)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AttachmentSystem, Attach)
+  UE_TRACE_EVENT_FIELD(uint64, Cycle)
+  UE_TRACE_EVENT_FIELD(uint32, Builder)
+  UE_TRACE_EVENT_FIELD(uint32, Child)
+  UE_TRACE_EVENT_FIELD(uint32, Parent)
+  UE_TRACE_EVENT_FIELD(int32, Slot)
+  UE_TRACE_EVENT_FIELD(bool, bAttached)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AttachmentSystem, RailProbe)
+  UE_TRACE_EVENT_FIELD(uint64, Cycle)
+  UE_TRACE_EVENT_FIELD(uint32, Builder)
+  UE_TRACE_EVENT_FIELD(float, X)
+  UE_TRACE_EVENT_FIELD(float, Y)
+  UE_TRACE_EVENT_FIELD(float, Z)
+  UE_TRACE_EVENT_FIELD(int32, Overlaps)
+  UE_TRACE_EVENT_FIELD(bool, bHit)
+UE_TRACE_EVENT_END()
+
+namespace {
+uint32 TraceId(const UObject *Object) {
+  return Object ? Object->GetUniqueID() : 0u;
+}
+} // namespace
+
+void AttachmentSystemTrace::OutputAmmo(const UObject *Owner,
+                                       const EAmmoOpType Op,
+                                       const EBulletType BulletType,
+                                       const int32 Count,
+                                       const int32 Remaining) {
+  UE_TRACE_LOG(AttachmentSystem, Ammo, AttachmentSystemChannel)
+      << Ammo.Cycle(FPlatformTime::Cycles64()) << Ammo.Owner(TraceId(Owner))
+      << Ammo.Op(static_cast<uint8>(Op))
+      << Ammo.BulletType(static_cast<uint8>(BulletType))
+      << Ammo.Count(Count) << Ammo.Remaining(Remaining);
+}
+
+void AttachmentSystemTrace::OutputFire(const UObject *Weapon,
+                                       const int32 Shots, const int32 Rounds,
+                                       const EBulletType FirstRound) {
+  UE_TRACE_LOG(AttachmentSystem, Fire, AttachmentSystemChannel)
+      << Fire.Cycle(FPlatformTime::Cycles64()) << Fire.Weapon(TraceId(Weapon))
+      << Fire.Shots(Shots) << Fire.Rounds(Rounds)
+      << Fire.FirstRound(static_cast<uint8>(FirstRound));
+}
+
+void AttachmentSystemTrace::OutputAttach(const UObject *Builder,
+                                         const UObject *Child,
+                                         const UObject *Parent,
+                                         const int32 Slot,
+                                         const bool bAttached) {
+  UE_TRACE_LOG(AttachmentSystem, Attach, AttachmentSystemChannel)
+      << Attach.Cycle(FPlatformTime::Cycles64())
+      << Attach.Builder(TraceId(Builder)) << Attach.Child(TraceId(Child))
+      << Attach.Parent(TraceId(Parent)) << Attach.Slot(Slot)
+      << Attach.bAttached(bAttached);
+}
+
+void AttachmentSystemTrace::OutputRailProbe(const UObject *Builder,
+                                            const FVector &Location,
+                                            const int32 Overlaps,
+                                            const bool bHit) {
+  UE_TRACE_LOG(AttachmentSystem, RailProbe, AttachmentSystemChannel)
+      << RailProbe.Cycle(FPlatformTime::Cycles64())
+      << RailProbe.Builder(TraceId(Builder))
+      << RailProbe.X(static_cast<float>(Location.X))
+      << RailProbe.Y(static_cast<float>(Location.Y))
+      << RailProbe.Z(static_cast<float>(Location.Z))
+      << RailProbe.Overlaps(Overlaps) << RailProbe.bHit(bHit);
+}
+
+#endif
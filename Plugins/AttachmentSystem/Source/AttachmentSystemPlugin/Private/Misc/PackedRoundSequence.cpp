@@ -0,0 +1,189 @@
+#include "Misc/PackedRoundSequence.h"
+
+EBulletType FPackedRoundSequence::ReadSlot(const int32 Slot) const {
+  const uint64 Word = Words[Slot / RoundsPerWord];
+  const int32 Shift = (Slot % RoundsPerWord) * BitsPerRound;
+  return static_cast<EBulletType>((Word >> Shift) & RoundMask);
+}
+
+void FPackedRoundSequence::WriteSlot(const int32 Slot, const EBulletType Type) {
+  const int32 WordIndex = Slot / RoundsPerWord;
+  if (WordIndex >= Words.Num()) {
+    Words.AddZeroed(WordIndex - Words.Num() + 1);
+  }
+
+  const int32 Shift = (Slot % RoundsPerWord) * BitsPerRound;
+  uint64 &Word = Words[WordIndex];
+  Word = (Word & ~(RoundMask << Shift)) |
+         ((static_cast<uint64>(Type) & RoundMask) << Shift);
+}
+
+void FPackedRoundSequence::ExpandRun() {
+  const int32 RunCount = Count;
+  Head = 0;
+  Words.Reset();
+  for (int32 i = 0; i < RunCount; ++i) {
+    WriteSlot(i, RunType);
+  }
+}
+
+void FPackedRoundSequence::PushBack(const EBulletType Type,
+                                    const int32 NumRounds) {
+  if (NumRounds <= 0)
+    return;
+
+  if (Count == 0) {
+    Reset();
+    RunType = Type;
+    Count = NumRounds;
+    return;
+  }
+
+  if (IsRunLength()) {
+    if (Type == RunType) {
+      Count += NumRounds;
+      return;
+    }
+    ExpandRun();
+  }
+
+  for (int32 i = 0; i < NumRounds; ++i) {
+    WriteSlot(Head + Count + i, Type);
+  }
+  Count += NumRounds;
+}
+
+void FPackedRoundSequence::Append(const TConstArrayView<EBulletType> Rounds) {
+  // Feed runs, so homogeneous input stays run-length encoded
+  int32 RunStart = 0;
+  for (int32 i = 1; i <= Rounds.Num(); ++i) {
+    if (i == Rounds.Num() || Rounds[i] != Rounds[RunStart]) {
+      PushBack(Rounds[RunStart], i - RunStart);
+      RunStart = i;
+    }
+  }
+}
+
+EBulletType FPackedRoundSequence::PopFront() {
+  if (Count == 0)
+    return EBulletType::None;
+
+  if (IsRunLength()) {
+    const EBulletType Type = RunType;
+    if (--Count == 0)
+      Reset();
+    return Type;
+  }
+
+  const EBulletType Type = ReadSlot(Head);
+  ++Head;
+  if (--Count == 0) {
+    Reset();
+  } else if (Head >= RoundsPerWord) {
+    // Drop the fully consumed word (once every RoundsPerWord pops)
+    Words.RemoveAt(0, 1, EAllowShrinking::No);
+    Head -= RoundsPerWord;
+  }
+  return Type;
+}
+
+int32 FPackedRoundSequence::PopFront(const int32 NumRounds,
+                                     TArray<EBulletType> &Out) {
+  const int32 ToPop = FMath::Clamp(NumRounds, 0, Count);
+  if (ToPop == 0)
+    return 0;
+
+  if (IsRunLength()) {
+    Out.Reserve(Out.Num() + ToPop);
+    for (int32 i = 0; i < ToPop; ++i) {
+      Out.Add(RunType);
+    }
+    Count -= ToPop;
+    if (Count == 0)
+      Reset();
+    return ToPop;
+  }
+
+  Out.Reserve(Out.Num() + ToPop);
+  for (int32 i = 0; i < ToPop; ++i) {
+    Out.Add(ReadSlot(Head + i));
+  }
+
+  Head += ToPop;
+  Count -= ToPop;
+  if (Count == 0) {
+    Reset();
+  } else if (Head >= RoundsPerWord) {
+    const int32 Consumed = Head / RoundsPerWord;
+    Words.RemoveAt(0, Consumed, EAllowShrinking::No);
+    Head -= Consumed * RoundsPerWord;
+  }
+  return ToPop;
+}
+
+EBulletType FPackedRoundSequence::operator[](const int32 Index) const {
+  check(Index >= 0 && Index < Count);
+  return IsRunLength() ? RunType : ReadSlot(Head + Index);
+}
+
+TArray<EBulletType> FPackedRoundSequence::ToArray() const {
+  TArray<EBulletType> Out;
+  Out.Reserve(Count);
+  for (int32 i = 0; i < Count; ++i) {
+    Out.Add((*this)[i]);
+  }
+  return Out;
+}
+
+void FPackedRoundSequence::Reset() {
+  Words.Reset();
+  Head = 0;
+  Count = 0;
+  RunType = EBulletType::None;
+}
+
+bool FPackedRoundSequence::NetSerialize(FArchive &Ar, UPackageMap *Map,
+                                        bool &bOutSuccess) {
+  uint32 NumRounds = static_cast<uint32>(Count);
+  Ar.SerializeIntPacked(NumRounds);
+
+  uint8 bRunLength = IsRunLength() ? 1 : 0;
+  Ar.SerializeBits(&bRunLength, 1);
+
+  if (Ar.IsLoading()) {
+    Reset();
+  }
+
+  if (bRunLength) {
+    uint8 Type = static_cast<uint8>(RunType);
+    Ar.SerializeBits(&Type, BitsPerRound);
+    if (Ar.IsLoading()) {
+      PushBack(static_cast<EBulletType>(Type), static_cast<int32>(NumRounds));
+    }
+  } else {
+    for (uint32 i = 0; i < NumRounds; ++i) {
+      uint8 Type = Ar.IsSaving() ? static_cast<uint8>((*this)[i]) : 0;
+      Ar.SerializeBits(&Type, BitsPerRound);
+      if (Ar.IsLoading()) {
+        // Written slot by slot so a mixed sequence stays packed on clients
+        WriteSlot(static_cast<int32>(i), static_cast<EBulletType>(Type));
+      }
+    }
+    if (Ar.IsLoading()) {
+      Count = static_cast<int32>(NumRounds);
+    }
+  }
+
+  bOutSuccess = !Ar.IsError();
+  return true;
+}
+
+bool FPackedRoundSequence::operator==(const FPackedRoundSequence &Other) const {
+  if (Count != Other.Count)
+    return false;
+  for (int32 i = 0; i < Count; ++i) {
+    if ((*this)[i] != Other[i])
+      return false;
+  }
+  return true;
+}
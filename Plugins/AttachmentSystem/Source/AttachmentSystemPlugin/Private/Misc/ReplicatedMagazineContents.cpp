@@ -0,0 +1,124 @@
+#include "Misc/ReplicatedMagazineContents.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Magazine Delta Bytes"),
+                               STAT_MagazineDeltaBytes,
+                               STATGROUP_AttachmentSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Magazine Deltas"), STAT_MagazineDeltas,
+                               STATGROUP_AttachmentSystem);
+
+namespace {
+/** Head/Tail last sent to one connection. */
+class FMagazineDeltaState : public INetDeltaBaseState {
+public:
+  FMagazineDeltaState(const uint32 InHead, const uint32 InTail)
+      : Head(InHead), Tail(InTail) {}
+
+  virtual bool IsStateEqual(INetDeltaBaseState *OtherState) override {
+    const FMagazineDeltaState *Other =
+        static_cast<FMagazineDeltaState *>(OtherState);
+    return Head == Other->Head && Tail == Other->Tail;
+  }
+
+  uint32 Head;
+  uint32 Tail;
+};
+} // namespace
+
+void FReplicatedMagazineContents::Load(const EBulletType Type,
+                                       const int32 NumRounds) {
+  if (NumRounds <= 0)
+    return;
+  Rounds.PushBack(Type, NumRounds);
+  Tail += NumRounds;
+}
+
+void FReplicatedMagazineContents::Load(
+    const TConstArrayView<EBulletType> NewRounds) {
+  Rounds.Append(NewRounds);
+  Tail += NewRounds.Num();
+}
+
+void FReplicatedMagazineContents::Consume(const int32 NumRounds) {
+  const int32 ToConsume = FMath::Clamp(NumRounds, 0, Rounds.Num());
+  for (int32 i = 0; i < ToConsume; ++i) {
+    Rounds.PopFront();
+  }
+  Head += ToConsume;
+}
+
+bool FReplicatedMagazineContents::NetDeltaSerialize(
+    FNetDeltaSerializeInfo &DeltaParms) {
+  // No object references to gather or remap
+  if (DeltaParms.GatherGuidReferences || DeltaParms.MoveGuidToUnmapped ||
+      DeltaParms.bUpdateUnmappedObjects) {
+    return false;
+  }
+
+  if (DeltaParms.Writer) {
+    const FMagazineDeltaState *OldState =
+        static_cast<FMagazineDeltaState *>(DeltaParms.OldState);
+    if (OldState && OldState->Head == Head && OldState->Tail == Tail)
+      return false; // nothing changed for this connection
+
+    *DeltaParms.NewState = MakeShared<FMagazineDeltaState>(Head, Tail);
+
+    FBitWriter &Writer = *DeltaParms.Writer;
+    const int64 StartBits = Writer.GetNumBits();
+
+    uint8 bFull = OldState ? 0 : 1;
+    Writer.SerializeBits(&bFull, 1);
+    Writer.SerializeIntPacked(Head);
+    Writer.SerializeIntPacked(Tail);
+
+    // Only rounds the client has not seen and that are still loaded
+    const uint32 From = bFull ? Head : FMath::Max(OldState->Tail, Head);
+    for (uint32 Index = From; Index < Tail; ++Index) {
+      uint8 Type = static_cast<uint8>(Rounds[Index - Head]);
+      Writer.SerializeBits(&Type, FPackedRoundSequence::BitsPerRound);
+    }
+
+    LastDeltaBytes =
+        static_cast<int32>((Writer.GetNumBits() - StartBits + 7) / 8);
+    TotalDeltaBytes += LastDeltaBytes;
+    INC_DWORD_STAT_BY(STAT_MagazineDeltaBytes, LastDeltaBytes);
+    INC_DWORD_STAT(STAT_MagazineDeltas);
+    return true;
+  }
+
+  if (DeltaParms.Reader) {
+    FBitReader &Reader = *DeltaParms.Reader;
+
+    uint8 bFull = 0;
+    uint32 NewHead = 0;
+    uint32 NewTail = 0;
+    Reader.SerializeBits(&bFull, 1);
+    Reader.SerializeIntPacked(NewHead);
+    Reader.SerializeIntPacked(NewTail);
+
+    if (bFull) {
+      Rounds.Reset();
+      Head = NewHead;
+      Tail = NewHead;
+    }
+
+    // Drop what the server consumed (possibly rounds we never received)
+    const uint32 Consumed = NewHead > Head ? NewHead - Head : 0;
+    TArray<EBulletType> Discard;
+    Rounds.PopFront(static_cast<int32>(FMath::Min<uint32>(
+                        Consumed, static_cast<uint32>(Rounds.Num()))),
+                    Discard);
+    Head = NewHead;
+    Tail = FMath::Max(Tail, NewHead);
+
+    for (uint32 Index = Tail; Index < NewTail; ++Index) {
+      uint8 Type = 0;
+      Reader.SerializeBits(&Type, FPackedRoundSequence::BitsPerRound);
+      Rounds.PushBack(static_cast<EBulletType>(Type));
+    }
+    Tail = FMath::Max(Tail, NewTail);
+
+    return !Reader.IsError();
+  }
+
+  return false;
+}
@@ -0,0 +1,31 @@
+#include "Misc/WeaponDurabilityTracker.h"
+
+#include "Algo/BinarySearch.h"
+
+void FWeaponDurabilityTracker::Add(const float Durability) {
+  Sorted.Insert(Durability, Algo::UpperBound(Sorted, Durability));
+  Sum += Durability;
+}
+
+void FWeaponDurabilityTracker::Remove(const float Durability) {
+  const int32 Index = Algo::BinarySearch(Sorted, Durability);
+  if (Index == INDEX_NONE)
+    return;
+
+  Sorted.RemoveAt(Index, 1, EAllowShrinking::No);
+  Sum -= Durability;
+}
+
+void FWeaponDurabilityTracker::Update(const float OldDurability,
+                                      const float NewDurability) {
+  if (OldDurability == NewDurability)
+    return;
+
+  Remove(OldDurability);
+  Add(NewDurability);
+}
+
+void FWeaponDurabilityTracker::Reset() {
+  Sorted.Reset();
+  Sum = 0.0;
+}
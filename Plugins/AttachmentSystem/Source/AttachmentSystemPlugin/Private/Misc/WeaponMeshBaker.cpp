@@ -0,0 +1,136 @@
+#include "Misc/WeaponMeshBaker.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshResources.h"
+
+UStaticMesh *WeaponMeshBaker::BakeStaticMeshes(
+    UObject *Outer, const TConstArrayView<UStaticMeshComponent *> Sources,
+    const FTransform &RootTransform,
+    TArray<UStaticMeshComponent *> &OutMerged) {
+  FMeshDescription Description;
+  FStaticMeshAttributes Attributes(Description);
+  Attributes.Register();
+
+  TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+  TVertexInstanceAttributesRef<FVector3f> Normals =
+      Attributes.GetVertexInstanceNormals();
+  TVertexInstanceAttributesRef<FVector3f> Tangents =
+      Attributes.GetVertexInstanceTangents();
+  TVertexInstanceAttributesRef<float> BinormalSigns =
+      Attributes.GetVertexInstanceBinormalSigns();
+  TVertexInstanceAttributesRef<FVector2f> UVs =
+      Attributes.GetVertexInstanceUVs();
+  TPolygonGroupAttributesRef<FName> SlotNames =
+      Attributes.GetPolygonGroupMaterialSlotNames();
+
+  TArray<FStaticMaterial> Materials;
+  TMap<UMaterialInterface *, FPolygonGroupID> GroupByMaterial;
+  TArray<FVertexID> VertexIDs;
+
+  for (UStaticMeshComponent *Source : Sources) {
+    UStaticMesh *Mesh = Source ? Source->GetStaticMesh() : nullptr;
+    const FStaticMeshRenderData *RenderData =
+        Mesh ? Mesh->GetRenderData() : nullptr;
+    if (!RenderData || RenderData->LODResources.IsEmpty())
+      continue;
+
+#if !WITH_EDITOR
+    // Cooked builds drop the CPU copy of vertex data unless asked to keep it
+    if (!Mesh->bAllowCPUAccess) {
+      UE_LOG(LogAttachmentSystem, Verbose,
+             TEXT("Bake skips %s: enable Allow CPU Access on the mesh"),
+             *Mesh->GetName());
+      continue;
+    }
+#endif
+
+    const FStaticMeshLODResources &LOD = RenderData->LODResources[0];
+    const FPositionVertexBuffer &PositionBuffer =
+        LOD.VertexBuffers.PositionVertexBuffer;
+    const FStaticMeshVertexBuffer &VertexBuffer =
+        LOD.VertexBuffers.StaticMeshVertexBuffer;
+    const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+    if (Indices.Num() == 0 || PositionBuffer.GetNumVertices() == 0)
+      continue;
+
+    const FTransform ToRoot =
+        Source->GetComponentTransform().GetRelativeTransform(RootTransform);
+    const bool bMirrored = ToRoot.GetDeterminant() < 0.f;
+
+    // Shared positions; normals/tangents/UVs go on the vertex instances
+    const int32 NumVertices =
+        static_cast<int32>(PositionBuffer.GetNumVertices());
+    VertexIDs.Reset(NumVertices);
+    Description.ReserveNewVertices(NumVertices);
+    for (int32 v = 0; v < NumVertices; ++v) {
+      const FVertexID VertexID = Description.CreateVertex();
+      Positions[VertexID] = FVector3f(ToRoot.TransformPosition(
+          FVector(PositionBuffer.VertexPosition(v))));
+      VertexIDs.Add(VertexID);
+    }
+
+    const int32 NumUVs = static_cast<int32>(VertexBuffer.GetNumTexCoords());
+
+    for (const FStaticMeshSection &Section : LOD.Sections) {
+      UMaterialInterface *Material = Source->GetMaterial(Section.MaterialIndex);
+
+      FPolygonGroupID *Group = GroupByMaterial.Find(Material);
+      if (!Group) {
+        const FPolygonGroupID NewGroup = Description.CreatePolygonGroup();
+        const FName SlotName =
+            Material ? Material->GetFName()
+                     : FName(TEXT("None"), Materials.Num() + 1);
+        SlotNames[NewGroup] = SlotName;
+        Materials.Emplace(Material, SlotName);
+        Group = &GroupByMaterial.Add(Material, NewGroup);
+      }
+
+      Description.ReserveNewVertexInstances(Section.NumTriangles * 3);
+      Description.ReserveNewPolygons(Section.NumTriangles);
+
+      for (uint32 Triangle = 0; Triangle < Section.NumTriangles; ++Triangle) {
+        FVertexInstanceID Corners[3];
+        for (int32 Corner = 0; Corner < 3; ++Corner) {
+          const uint32 Vertex =
+              Indices[Section.FirstIndex + Triangle * 3 + Corner];
+
+          const FVertexInstanceID Instance =
+              Description.CreateVertexInstance(VertexIDs[Vertex]);
+          const FVector4f TangentZ = VertexBuffer.VertexTangentZ(Vertex);
+          Normals[Instance] = FVector3f(
+              ToRoot.TransformVectorNoScale(FVector(FVector3f(TangentZ))));
+          Tangents[Instance] = FVector3f(ToRoot.TransformVectorNoScale(
+              FVector(FVector3f(VertexBuffer.VertexTangentX(Vertex)))));
+          BinormalSigns[Instance] = TangentZ.W < 0.f ? -1.f : 1.f;
+          UVs[Instance] =
+              NumUVs > 0 ? VertexBuffer.GetVertexUV(Vertex, 0)
+                         : FVector2f::ZeroVector;
+          Corners[Corner] = Instance;
+        }
+
+        // Negative scale flips winding
+        if (bMirrored) {
+          Swap(Corners[1], Corners[2]);
+        }
+        Description.CreatePolygon(*Group, MakeArrayView(Corners));
+      }
+    }
+
+    OutMerged.Add(Source);
+  }
+
+  if (OutMerged.IsEmpty())
+    return nullptr;
+
+  UStaticMesh *Merged = NewObject<UStaticMesh>(Outer, NAME_None, RF_Transient);
+  Merged->SetStaticMaterials(Materials);
+
+  UStaticMesh::FBuildMeshDescriptionsParams Params;
+  Params.bFastBuild = true;
+  Params.bBuildSimpleCollision = false;
+  Merged->BuildFromMeshDescriptions({&Description}, Params);
+  return Merged;
+}
@@ -0,0 +1,143 @@
+#include "Misc/WeaponStatEngine.h"
+
+FWeaponStatEngine::FWeaponStatEngine() {
+  for (int32 i = 0; i < NumWeaponStatLanes; ++i) {
+    Base[i] = 0.f;
+    Flat[i] = 0.f;
+    Percent[i] = 1.f;
+    OverrideMask[i] = 0.f;
+    OverrideValue[i] = 0.f;
+    Final[i] = 0.f;
+  }
+}
+
+void FWeaponStatEngine::SetBaseStats(const TMap<EWeaponStat, float> &BaseStats) {
+  for (int32 i = 0; i < NumWeaponStatLanes; ++i) {
+    Base[i] = 0.f;
+  }
+  for (const TPair<EWeaponStat, float> &Pair : BaseStats) {
+    const int32 Index = static_cast<int32>(Pair.Key);
+    if (Index < NumWeaponStats) {
+      Base[Index] = Pair.Value;
+    }
+  }
+  bDirty = true;
+}
+
+void FWeaponStatEngine::AddModifiers(
+    const UObject *Source, const TConstArrayView<FStatModifier> Modifiers) {
+  const FObjectKey SourceKey(Source);
+  if (Sources.Contains(SourceKey))
+    return;
+  Sources.Add(SourceKey);
+
+  uint64 StatMask = 0;
+  for (const FStatModifier &Modifier : Modifiers) {
+    const int32 Index = static_cast<int32>(Modifier.StatToModify);
+    if (Index >= NumWeaponStats ||
+        Modifier.ModificationType == EStatModType::SMT_MAX)
+      continue;
+
+    Contributions.Add({SourceKey, Modifier.StatToModify,
+                       Modifier.ModificationType, Modifier.Value});
+    StatMask |= 1ull << Index;
+  }
+
+  RebuildColumns(StatMask);
+}
+
+void FWeaponStatEngine::RemoveModifiers(const UObject *Source) {
+  const FObjectKey SourceKey(Source);
+  if (Sources.Remove(SourceKey) == 0)
+    return;
+
+  uint64 StatMask = 0;
+  Contributions.RemoveAll([&](const FContribution &Contribution) {
+    if (Contribution.Source != SourceKey)
+      return false;
+    StatMask |= 1ull << static_cast<int32>(Contribution.Stat);
+    return true;
+  });
+
+  RebuildColumns(StatMask);
+}
+
+void FWeaponStatEngine::ClearModifiers() {
+  Contributions.Reset();
+  Sources.Reset();
+  RebuildColumns(~0ull);
+}
+
+void FWeaponStatEngine::RebuildColumns(const uint64 StatMask) {
+  if (StatMask == 0)
+    return;
+
+  for (int32 i = 0; i < NumWeaponStats; ++i) {
+    if (StatMask & (1ull << i)) {
+      Flat[i] = 0.f;
+      Percent[i] = 1.f;
+      OverrideMask[i] = 0.f;
+      OverrideValue[i] = 0.f;
+    }
+  }
+
+  // Single pass in add order, so the last override wins
+  for (const FContribution &Contribution : Contributions) {
+    const int32 Index = static_cast<int32>(Contribution.Stat);
+    if (!(StatMask & (1ull << Index)))
+      continue;
+
+    switch (Contribution.Type) {
+    case EStatModType::SMT_Flat:
+      Flat[Index] += Contribution.Value;
+      break;
+    case EStatModType::SMT_Percentage:
+      Percent[Index] *= Contribution.Value;
+      break;
+    case EStatModType::SMT_Override:
+      OverrideMask[Index] = 1.f;
+      OverrideValue[Index] = Contribution.Value;
+      break;
+    default:
+      break;
+    }
+  }
+
+  bDirty = true;
+}
+
+void FWeaponStatEngine::Evaluate() const {
+  for (int32 i = 0; i < NumWeaponStatLanes; i += 4) {
+    const VectorRegister4Float BaseV = VectorLoadAligned(&Base[i]);
+    const VectorRegister4Float MaskV = VectorLoadAligned(&OverrideMask[i]);
+    const VectorRegister4Float OverrideV = VectorLoadAligned(&OverrideValue[i]);
+
+    // Mask is 0 or 1: Base + Mask * (Override - Base)
+    const VectorRegister4Float Start =
+        VectorMultiplyAdd(MaskV, VectorSubtract(OverrideV, BaseV), BaseV);
+    const VectorRegister4Float Summed =
+        VectorAdd(Start, VectorLoadAligned(&Flat[i]));
+
+    VectorStoreAligned(VectorMultiply(Summed, VectorLoadAligned(&Percent[i])),
+                       &Final[i]);
+  }
+  bDirty = false;
+}
+
+float FWeaponStatEngine::GetStat(const EWeaponStat Stat) const {
+  const int32 Index = static_cast<int32>(Stat);
+  if (Index >= NumWeaponStats)
+    return 0.f;
+
+  if (bDirty) {
+    Evaluate();
+  }
+  return Final[Index];
+}
+
+TConstArrayView<float> FWeaponStatEngine::GetFinalStats() const {
+  if (bDirty) {
+    Evaluate();
+  }
+  return TConstArrayView<float>(Final, NumWeaponStats);
+}
@@ -0,0 +1,47 @@
+#include "Subsystems/AttachmentDefinitionStore.h"
+
+#include "Engine/DataTable.h"
+
+TSharedPtr<const FAttachmentInfo>
+UAttachmentDefinitionStore::FindDefinition(const UDataTable *DataTable,
+                                           const FName RowName) {
+  if (!DataTable)
+    return nullptr;
+
+  const FDefinitionKey Key(FObjectKey(DataTable), RowName);
+  if (const TSharedPtr<const FAttachmentInfo> *Found = Definitions.Find(Key)) {
+    return *Found;
+  }
+
+  const FAttachmentInfo *Row = DataTable->FindRow<FAttachmentInfo>(
+      RowName, TEXT("Resolving attachment definition"));
+  if (!Row)
+    return nullptr;
+
+#if WITH_EDITOR
+  // Row edits/reimports must not keep serving the stale copy
+  if (!WatchedTables.Contains(FObjectKey(DataTable))) {
+    WatchedTables.Add(FObjectKey(DataTable));
+    const_cast<UDataTable *>(DataTable)->OnDataTableChanged().AddWeakLambda(
+        this, [this, DataTable]() { InvalidateTable(DataTable); });
+  }
+#endif
+
+  TSharedPtr<const FAttachmentInfo> Definition =
+      MakeShared<const FAttachmentInfo>(*Row);
+  Definitions.Add(Key, Definition);
+  return Definition;
+}
+
+void UAttachmentDefinitionStore::InvalidateDefinitions() {
+  Definitions.Empty();
+}
+
+void UAttachmentDefinitionStore::InvalidateTable(const UDataTable *DataTable) {
+  const FObjectKey TableKey(DataTable);
+  for (auto It = Definitions.CreateIterator(); It; ++It) {
+    if (It.Key().Key == TableKey) {
+      It.RemoveCurrent();
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#include "Subsystems/AttachmentPoolSubsystem.h"
+
+#include "Actors/Attachment.h"
+#include "Engine/World.h"
+
+void UAttachmentPoolSubsystem::Deinitialize() {
+  EmptyPool();
+  Super::Deinitialize();
+}
+
+AAttachment *
+UAttachmentPoolSubsystem::Acquire(const TSubclassOf<AAttachment> AttachmentClass,
+                                  AActor *Owner) {
+  UWorld *World = GetWorld();
+  if (!*AttachmentClass || !World)
+    return nullptr;
+
+  // Reuse an idle actor of the exact class if we have one
+  if (FAttachmentPoolBucket *Bucket = Pool.Find(AttachmentClass)) {
+    while (Bucket->Attachments.Num() > 0) {
+      AAttachment *Pooled = Bucket->Attachments.Pop(EAllowShrinking::No);
+      --PoolStats.PoolSize;
+
+      // Pooled actors can still be destroyed externally (level unload, etc.)
+      if (!IsValid(Pooled))
+        continue;
+
+      ++PoolStats.Hits;
+      Pooled->SetOwner(Owner);
+      Pooled->SetActorHiddenInGame(false);
+      Pooled->SetActorEnableCollision(true);
+      return Pooled;
+    }
+  }
+
+  ++PoolStats.Misses;
+
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.Owner = Owner;
+  SpawnParams.SpawnCollisionHandlingOverride =
+      ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+  return World->SpawnActor<AAttachment>(AttachmentClass, FVector::ZeroVector,
+                                        FRotator::ZeroRotator, SpawnParams);
+}
+
+void UAttachmentPoolSubsystem::Release(AAttachment *Attachment) {
+  if (!IsValid(Attachment))
+    return;
+
+  Attachment->ResetForPool();
+  Attachment->SetActorHiddenInGame(true);
+  Attachment->SetActorEnableCollision(false);
+  Attachment->SetOwner(nullptr);
+
+  FAttachmentPoolBucket &Bucket = Pool.FindOrAdd(Attachment->GetClass());
+  const int32 NumBefore = Bucket.Attachments.Num();
+  Bucket.Attachments.AddUnique(Attachment);
+
+  PoolStats.PoolSize += Bucket.Attachments.Num() - NumBefore;
+  PoolStats.PeakPoolSize =
+      FMath::Max(PoolStats.PeakPoolSize, PoolStats.PoolSize);
+}
+
+void UAttachmentPoolSubsystem::EmptyPool() {
+  for (TPair<TSubclassOf<AAttachment>, FAttachmentPoolBucket> &Pair : Pool) {
+    for (AAttachment *Attachment : Pair.Value.Attachments) {
+      if (IsValid(Attachment)) {
+        Attachment->Destroy();
+      }
+    }
+  }
+
+  Pool.Empty();
+  PoolStats.PoolSize = 0;
+}
@@ -0,0 +1,113 @@
+#include "Subsystems/AttachmentTickSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attachment Tick Manager"), STAT_AttachmentTickManager,
+                   STATGROUP_AttachmentSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attachment Tick Callbacks"),
+                           STAT_AttachmentTickCallbacks,
+                           STATGROUP_AttachmentSystem);
+
+FAttachmentTickHandle UAttachmentTickSubsystem::RegisterTick(
+    const UObject *Owner, FAttachmentTickDelegate Callback,
+    const float Interval) {
+  FAttachmentTickHandle Handle;
+  if (!Owner || !Callback.IsBound())
+    return Handle;
+
+  Handle.Id = NextId++;
+  if (NextId == 0) {
+    NextId = 1; // 0 is the invalid handle
+  }
+
+  FTickEntry &Entry = Entries.AddDefaulted_GetRef();
+  Entry.Owner = Owner;
+  Entry.Callback = MoveTemp(Callback);
+  Entry.Interval = FMath::Max(Interval, 0.f);
+  Entry.Id = Handle.Id;
+  IndexById.Add(Handle.Id, Entries.Num() - 1);
+  return Handle;
+}
+
+void UAttachmentTickSubsystem::UnregisterTick(FAttachmentTickHandle &Handle) {
+  if (const int32 *Index = IndexById.Find(Handle.Id)) {
+    if (bTicking) {
+      // Dropped at the end of the current walk
+      Entries[*Index].Callback.Unbind();
+    } else {
+      RemoveAt(*Index);
+    }
+  }
+  Handle.Invalidate();
+}
+
+void UAttachmentTickSubsystem::UnregisterAllTicks(const UObject *Owner) {
+  for (int32 i = Entries.Num() - 1; i >= 0; --i) {
+    if (Entries[i].Owner.Get() != Owner)
+      continue;
+    if (bTicking) {
+      Entries[i].Callback.Unbind();
+    } else {
+      RemoveAt(i);
+    }
+  }
+}
+
+void UAttachmentTickSubsystem::SetTickInterval(
+    const FAttachmentTickHandle &Handle, const float Interval) {
+  if (const int32 *Index = IndexById.Find(Handle.Id)) {
+    Entries[*Index].Interval = FMath::Max(Interval, 0.f);
+  }
+}
+
+void UAttachmentTickSubsystem::RemoveAt(const int32 Index) {
+  IndexById.Remove(Entries[Index].Id);
+
+  const int32 Last = Entries.Num() - 1;
+  if (Index != Last) {
+    IndexById[Entries[Last].Id] = Index;
+  }
+  Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAttachmentTickSubsystem::Tick(const float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_AttachmentTickManager);
+  if (Entries.IsEmpty())
+    return;
+
+  // Callbacks may register more entries; those start next frame
+  const int32 NumEntries = Entries.Num();
+  int32 NumCalled = 0;
+
+  bTicking = true;
+  for (int32 i = 0; i < NumEntries; ++i) {
+    FTickEntry &Entry = Entries[i];
+    if (!Entry.Callback.IsBound() || !Entry.Owner.IsValid())
+      continue;
+
+    Entry.Accumulated += DeltaTime;
+    if (Entry.Accumulated < Entry.Interval)
+      continue;
+
+    const float Elapsed = Entry.Accumulated;
+    Entry.Accumulated = 0.f;
+
+    // Copy: the callback may grow Entries and move this one
+    FAttachmentTickDelegate Callback = Entry.Callback;
+    Callback.Execute(Elapsed);
+    ++NumCalled;
+  }
+  bTicking = false;
+
+  // Drop unregistered entries and those whose owner is gone
+  for (int32 i = Entries.Num() - 1; i >= 0; --i) {
+    if (!Entries[i].Callback.IsBound() || !Entries[i].Owner.IsValid()) {
+      RemoveAt(i);
+    }
+  }
+
+  INC_DWORD_STAT_BY(STAT_AttachmentTickCallbacks, NumCalled);
+}
+
+TStatId UAttachmentTickSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UAttachmentTickSubsystem,
+                                  STATGROUP_Tickables);
+}
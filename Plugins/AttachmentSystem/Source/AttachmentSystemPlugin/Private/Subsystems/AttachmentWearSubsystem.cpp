@@ -0,0 +1,61 @@
+#include "Subsystems/AttachmentWearSubsystem.h"
+
+#include "Actors/Attachment.h"
+
+void UAttachmentWearSubsystem::ApplyBatchWear(
+    const TConstArrayView<AAttachment *> Attachments, const int32 Shots,
+    const float WearPerShot,
+    const TConstArrayView<float> CategoryCoefficients) {
+  if (Shots <= 0 || WearPerShot <= 0.f)
+    return;
+
+  // Gather: one packed lane per live attachment
+  Parts.Reset();
+  Durabilities.Reset();
+  Coefficients.Reset();
+
+  for (AAttachment *Attachment : Attachments) {
+    if (!IsValid(Attachment))
+      continue;
+
+    const int32 Category =
+        static_cast<int32>(Attachment->GetAttachmentCategory());
+    Parts.Add(Attachment);
+    Durabilities.Add(Attachment->GetDurability());
+    Coefficients.Add(CategoryCoefficients.IsValidIndex(Category)
+                         ? CategoryCoefficients[Category]
+                         : 1.f);
+  }
+
+  const int32 NumParts = Parts.Num();
+  if (NumParts == 0)
+    return;
+
+  // Pad to whole vectors; padded lanes are never written back
+  const int32 NumLanes = Align(NumParts, 4);
+  Durabilities.SetNumZeroed(NumLanes);
+  Coefficients.SetNumZeroed(NumLanes);
+
+  // Durability = max(0, Durability - Coefficient * Shots * WearPerShot)
+  const VectorRegister4Float Scale =
+      VectorSetFloat1(static_cast<float>(Shots) * WearPerShot);
+  float *DurabilityData = Durabilities.GetData();
+  const float *CoefficientData = Coefficients.GetData();
+
+  for (int32 i = 0; i < NumLanes; i += 4) {
+    const VectorRegister4Float Wear =
+        VectorMultiply(VectorLoadAligned(&CoefficientData[i]), Scale);
+    const VectorRegister4Float Worn =
+        VectorSubtract(VectorLoadAligned(&DurabilityData[i]), Wear);
+    VectorStoreAligned(VectorMax(Worn, GlobalVectorConstants::FloatZero),
+                       &DurabilityData[i]);
+  }
+
+  // Scatter back through the setter so listeners see the change
+  for (int32 i = 0; i < NumParts; ++i) {
+    Parts[i]->SetDurability(DurabilityData[i]);
+  }
+
+  WornAttachments += NumParts;
+  ++Batches;
+}
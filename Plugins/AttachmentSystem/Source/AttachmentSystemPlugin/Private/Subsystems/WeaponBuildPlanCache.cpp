@@ -0,0 +1,105 @@
+#include "Subsystems/WeaponBuildPlanCache.h"
+
+#include "Actors/Attachment.h"
+#include "Misc/AttachmentSocketMapping.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+void UWeaponBuildPlanCache::Initialize(FSubsystemCollectionBase &Collection) {
+  Super::Initialize(Collection);
+
+#if WITH_EDITOR
+  // Plans hold classes and overlap results from one session; never carry
+  // them into the next PIE run or past a Blueprint recompile
+  EndPIEHandle =
+      FEditorDelegates::EndPIE.AddUObject(this, &ThisClass::HandleEndPIE);
+  ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(
+      this, &ThisClass::HandleObjectsReplaced);
+  ObjectPropertyChangedHandle =
+      FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+          this, &ThisClass::HandleObjectPropertyChanged);
+#endif
+}
+
+void UWeaponBuildPlanCache::Deinitialize() {
+#if WITH_EDITOR
+  FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+  FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+  FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(
+      ObjectPropertyChangedHandle);
+#endif
+  Plans.Empty();
+
+  Super::Deinitialize();
+}
+
+const FWeaponBuildPlan *UWeaponBuildPlanCache::FindPlan(
+    const TConstArrayView<TSubclassOf<AAttachment>> RootClasses,
+    const UAttachmentSocketMapping *SocketMapping) const {
+  const FWeaponBuildPlan *Plan =
+      Plans.Find(HashConfiguration(RootClasses, SocketMapping));
+  if (!Plan)
+    return nullptr;
+
+  // Hash collision guard
+  if (Plan->SocketMapping != SocketMapping ||
+      Plan->RootClasses.Num() != RootClasses.Num())
+    return nullptr;
+  for (int32 i = 0; i < RootClasses.Num(); ++i) {
+    if (Plan->RootClasses[i] != RootClasses[i])
+      return nullptr;
+  }
+
+  return Plan;
+}
+
+void UWeaponBuildPlanCache::StorePlan(FWeaponBuildPlan &&Plan) {
+  const uint32 Hash = HashConfiguration(Plan.RootClasses, Plan.SocketMapping);
+  Plans.Add(Hash, MoveTemp(Plan));
+}
+
+void UWeaponBuildPlanCache::InvalidatePlans() { Plans.Empty(); }
+
+void UWeaponBuildPlanCache::InvalidateMapping(
+    const UAttachmentSocketMapping *SocketMapping) {
+  for (auto It = Plans.CreateIterator(); It; ++It) {
+    if (It.Value().SocketMapping == SocketMapping) {
+      It.RemoveCurrent();
+    }
+  }
+}
+
+#if WITH_EDITOR
+void UWeaponBuildPlanCache::HandleEndPIE(const bool bIsSimulating) {
+  InvalidatePlans();
+}
+
+void UWeaponBuildPlanCache::HandleObjectsReplaced(
+    const TMap<UObject *, UObject *> &ReplacedObjects) {
+  // Blueprint compile/reinstance: recorded classes may be stale
+  if (Plans.Num() > 0 && ReplacedObjects.Num() > 0) {
+    InvalidatePlans();
+  }
+}
+
+void UWeaponBuildPlanCache::HandleObjectPropertyChanged(
+    UObject *Object, FPropertyChangedEvent &PropertyChangedEvent) {
+  if (const UAttachmentSocketMapping *SocketMapping =
+          Cast<UAttachmentSocketMapping>(Object)) {
+    InvalidateMapping(SocketMapping);
+  }
+}
+#endif
+
+uint32 UWeaponBuildPlanCache::HashConfiguration(
+    const TConstArrayView<TSubclassOf<AAttachment>> RootClasses,
+    const UAttachmentSocketMapping *SocketMapping) {
+  uint32 Hash = HashCombine(GetTypeHash(RootClasses.Num()),
+                            GetTypeHash(SocketMapping));
+  for (const TSubclassOf<AAttachment> &RootClass : RootClasses) {
+    Hash = HashCombine(Hash, GetTypeHash(RootClass.Get()));
+  }
+  return Hash;
+}
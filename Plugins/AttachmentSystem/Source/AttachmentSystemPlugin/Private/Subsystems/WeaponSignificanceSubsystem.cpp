@@ -0,0 +1,197 @@
+#include "Subsystems/WeaponSignificanceSubsystem.h"
+
+#include "Actors/Weapon.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Significance"), STAT_WeaponSignificance,
+                   STATGROUP_AttachmentSystem);
+
+namespace {
+TAutoConsoleVariable<int32> CVarFullBudget(
+    TEXT("AttachmentSystem.Significance.FullBudget"), 8,
+    TEXT("Max weapons drawn at Full detail (local weapons always are)."));
+
+TAutoConsoleVariable<int32> CVarReducedBudget(
+    TEXT("AttachmentSystem.Significance.ReducedBudget"), 24,
+    TEXT("Max weapons drawn at Reduced detail; the rest are Merged."));
+
+TAutoConsoleVariable<float> CVarFullDistance(
+    TEXT("AttachmentSystem.Significance.FullDistance"), 1500.f,
+    TEXT("Distance (cm) up to which remote weapons may be Full."));
+
+TAutoConsoleVariable<float> CVarReducedDistance(
+    TEXT("AttachmentSystem.Significance.ReducedDistance"), 4000.f,
+    TEXT("Distance (cm) up to which remote weapons may be Reduced."));
+
+TAutoConsoleVariable<float> CVarUpdateInterval(
+    TEXT("AttachmentSystem.Significance.UpdateInterval"), 0.25f,
+    TEXT("Seconds between significance updates."));
+
+/** Seconds since last render for a weapon to count as visible. */
+constexpr float VisibleTolerance = 0.5f;
+
+FAutoConsoleCommandWithWorld DumpWeaponTiersCommand(
+    TEXT("AttachmentSystem.DumpWeaponTiers"),
+    TEXT("Logs how many weapons are at each detail tier."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World) {
+      if (const UWeaponSignificanceSubsystem *Significance =
+              World ? World->GetSubsystem<UWeaponSignificanceSubsystem>()
+                    : nullptr) {
+        Significance->DumpTiers();
+      }
+    }));
+
+/**
+ * The weapon actor often draws nothing itself. Compact parts and the merged
+ * mesh are its components; every other part is an attachment actor attached
+ * under it (on the server and on clients alike).
+ */
+bool WasWeaponRecentlyRendered(const AWeapon *Weapon,
+                               TArray<AActor *> &PartsScratch) {
+  if (Weapon->WasRecentlyRendered(VisibleTolerance))
+    return true;
+
+  Weapon->GetAttachedActors(PartsScratch, /*bResetArray=*/true,
+                            /*bRecursivelyIncludeAttachedActors=*/true);
+  for (const AActor *Part : PartsScratch) {
+    if (Part && Part->WasRecentlyRendered(VisibleTolerance))
+      return true;
+  }
+  return false;
+}
+
+struct FWeaponRank {
+  AWeapon *Weapon = nullptr;
+  float DistanceSq = 0.f;
+  bool bLocal = false;
+  bool bVisible = false;
+
+  bool operator<(const FWeaponRank &Other) const {
+    if (bLocal != Other.bLocal)
+      return bLocal;
+    if (bVisible != Other.bVisible)
+      return bVisible;
+    return DistanceSq < Other.DistanceSq;
+  }
+};
+} // namespace
+
+void UWeaponSignificanceSubsystem::RegisterWeapon(AWeapon *Weapon) {
+  if (Weapon) {
+    Weapons.AddUnique(Weapon);
+  }
+}
+
+void UWeaponSignificanceSubsystem::UnregisterWeapon(AWeapon *Weapon) {
+  Weapons.RemoveSingleSwap(Weapon, EAllowShrinking::No);
+}
+
+void UWeaponSignificanceSubsystem::Tick(const float DeltaTime) {
+  TimeSinceUpdate += DeltaTime;
+  if (TimeSinceUpdate < CVarUpdateInterval.GetValueOnGameThread())
+    return;
+  TimeSinceUpdate = 0.f;
+
+  UpdateSignificance();
+}
+
+void UWeaponSignificanceSubsystem::UpdateSignificance() {
+  SCOPE_CYCLE_COUNTER(STAT_WeaponSignificance);
+
+  UWorld *World = GetWorld();
+  if (!World)
+    return;
+
+  // Local view points (split screen can have several)
+  TArray<FVector, TInlineAllocator<4>> ViewPoints;
+  for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator();
+       It; ++It) {
+    const APlayerController *Controller = It->Get();
+    if (!Controller || !Controller->IsLocalController())
+      continue;
+
+    FVector Location;
+    FRotator Rotation;
+    Controller->GetPlayerViewPoint(Location, Rotation);
+    ViewPoints.Add(Location);
+  }
+  if (ViewPoints.IsEmpty())
+    return;
+
+  TArray<FWeaponRank> Ranks;
+  Ranks.Reserve(Weapons.Num());
+  TArray<AActor *> PartsScratch;
+  for (int32 i = Weapons.Num() - 1; i >= 0; --i) {
+    AWeapon *Weapon = Weapons[i].Get();
+    if (!Weapon) {
+      Weapons.RemoveAtSwap(i, 1, EAllowShrinking::No);
+      continue;
+    }
+
+    FWeaponRank &Rank = Ranks.AddDefaulted_GetRef();
+    Rank.Weapon = Weapon;
+    Rank.bLocal = Weapon->IsOwnedByLocalPlayer();
+
+    // The weapon and its parts, or the character carrying it
+    const AActor *Carrier = Weapon->GetOwner();
+    Rank.bVisible = WasWeaponRecentlyRendered(Weapon, PartsScratch) ||
+                    (Carrier && Carrier->WasRecentlyRendered(VisibleTolerance));
+
+    const FVector Location = Weapon->GetActorLocation();
+    Rank.DistanceSq = TNumericLimits<float>::Max();
+    for (const FVector &ViewPoint : ViewPoints) {
+      Rank.DistanceSq = FMath::Min(
+          Rank.DistanceSq, static_cast<float>(FVector::DistSquared(
+                               Location, ViewPoint)));
+    }
+  }
+
+  Ranks.Sort();
+
+  const int32 FullBudget = CVarFullBudget.GetValueOnGameThread();
+  const int32 ReducedBudget = CVarReducedBudget.GetValueOnGameThread();
+  const float FullDistanceSq =
+      FMath::Square(CVarFullDistance.GetValueOnGameThread());
+  const float ReducedDistanceSq =
+      FMath::Square(CVarReducedDistance.GetValueOnGameThread());
+
+  FMemory::Memzero(TierCounts);
+  for (const FWeaponRank &Rank : Ranks) {
+    EWeaponDetailTier Tier = EWeaponDetailTier::Merged;
+    if (Rank.bLocal) {
+      Tier = EWeaponDetailTier::Full;
+    } else if (Rank.bVisible) {
+      if (Rank.DistanceSq <= FullDistanceSq &&
+          TierCounts[static_cast<int32>(EWeaponDetailTier::Full)] <
+              FullBudget) {
+        Tier = EWeaponDetailTier::Full;
+      } else if (Rank.DistanceSq <= ReducedDistanceSq &&
+                 TierCounts[static_cast<int32>(EWeaponDetailTier::Reduced)] <
+                     ReducedBudget) {
+        Tier = EWeaponDetailTier::Reduced;
+      }
+    }
+
+    ++TierCounts[static_cast<int32>(Tier)];
+    Rank.Weapon->SetDetailTier(Tier);
+  }
+}
+
+void UWeaponSignificanceSubsystem::DumpTiers() const {
+  UE_LOG(LogAttachmentSystem, Display,
+         TEXT("Weapon detail tiers (%d weapons): Full %d/%d | Reduced %d/%d | "
+              "Merged %d"),
+         Weapons.Num(),
+         TierCounts[static_cast<int32>(EWeaponDetailTier::Full)],
+         CVarFullBudget.GetValueOnGameThread(),
+         TierCounts[static_cast<int32>(EWeaponDetailTier::Reduced)],
+         CVarReducedBudget.GetValueOnGameThread(),
+         TierCounts[static_cast<int32>(EWeaponDetailTier::Merged)]);
+}
+
+TStatId UWeaponSignificanceSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponSignificanceSubsystem,
+                                  STATGROUP_Tickables);
+}
@@ -0,0 +1,439 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/Attachment.h"
+#include "Actors/BarrelAttachment.h"
+#include "Actors/MagazineAttachment.h"
+#include "Actors/Weapon.h"
+#include "Components/WeaponBuilderComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Tests/AttachmentSystemBenchmarkGraph.h"
+
+/**
+ * Headless benchmark of the weapon lifecycle: build N weapons from a fixed
+ * attachment graph, fire M rounds each (refilling the magazine as needed),
+ * then clear them. Reports median / p99 per phase and allocations per
+ * weapon, as a JSON file and as one "AttachmentBenchmark:" log line.
+ *
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -nosplash -nosound
+ *     -ExecCmds="Automation RunTests AttachmentSystem.Benchmark; Quit"
+ *
+ * Options:
+ *   -AttachmentBenchWeapons=64      weapons built per run
+ *   -AttachmentBenchRounds=300      rounds fired per weapon
+ *   -AttachmentBenchWeapon=<class>  weapon class with its own graph; the
+ *                                   default is the native 8-part graph of
+ *                                   AttachmentSystemBenchmarkParts.h
+ *   -AttachmentBenchMesh=<path>     skeletal mesh of the native parts; its
+ *                                   root bone serves as every socket
+ *   -AttachmentBenchOut=<dir>       output directory (Saved/Automation)
+ *
+ * AttachmentSystem.Benchmark.CompactBuild builds the same N weapons once
+ * with one actor per part and once with bCompactBuild, and reports the
+ * measured footprint per weapon (replicated actors, tick functions, mesh
+ * components, draw sections) and the world tick time each mode adds per
+ * weapon (-AttachmentBenchFrames=120 frames, median).
+ */
+namespace AttachmentSystemBenchmark {
+
+struct FPhaseSamples {
+  TArray<double> Ms;
+  uint64 Allocations = 0;
+};
+
+struct FAllocScope {
+  explicit FAllocScope(uint64 &InTotal)
+      : Total(InTotal), Start(CurrentAllocations()) {}
+  ~FAllocScope() { Total += CurrentAllocations() - Start; }
+
+  static uint64 CurrentAllocations() {
+    // Malloc + Realloc calls; counted by GMalloc outside of shipping
+    return FMalloc::TotalMallocCalls.load(std::memory_order_relaxed) +
+           FMalloc::TotalReallocCalls.load(std::memory_order_relaxed);
+  }
+
+  uint64 &Total;
+  uint64 Start;
+};
+
+double Percentile(TArray<double> Sorted, const double Fraction) {
+  if (Sorted.Num() == 0)
+    return 0.0;
+  Sorted.Sort();
+  const int32 Index = FMath::Clamp(
+      FMath::CeilToInt32(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+  return Sorted[Index];
+}
+
+TSharedRef<FJsonObject> PhaseToJson(const FPhaseSamples &Phase,
+                                    const int32 NumWeapons) {
+  TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+  Json->SetNumberField(TEXT("medianMs"), Percentile(Phase.Ms, 0.5));
+  Json->SetNumberField(TEXT("p99Ms"), Percentile(Phase.Ms, 0.99));
+  Json->SetNumberField(TEXT("maxMs"), Percentile(Phase.Ms, 1.0));
+  Json->SetNumberField(TEXT("samples"), Phase.Ms.Num());
+  Json->SetNumberField(TEXT("allocationsPerWeapon"),
+                       NumWeapons > 0
+                           ? static_cast<double>(Phase.Allocations) / NumWeapons
+                           : 0.0);
+  return Json;
+}
+
+/** Spawns WeaponClass; the native graph is applied when it is set (plain
+ *  AWeapon), content weapons keep their own. */
+AWeapon *SpawnBenchmarkWeapon(UWorld *World, UClass *WeaponClass,
+                              const FNativeGraph *NativeGraph,
+                              const bool bUseBuildPlanCache) {
+  AWeapon *Weapon = World->SpawnActor<AWeapon>(WeaponClass);
+  if (!Weapon || !Weapon->GetWeaponBuilder())
+    return nullptr;
+
+  UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+  if (NativeGraph) {
+    NativeGraph->Apply(Builder);
+  }
+  Builder->SetUseBuildPlanCache(bUseBuildPlanCache);
+  return Weapon;
+}
+
+/** Builds and clears Weapon once: streams meshes, fills the pool and (if
+ *  on) the plan cache. Fails if the native graph did not build completely,
+ *  so the benchmark never times a partial weapon. */
+bool WarmUp(FAutomationTestBase &Test, AWeapon *Weapon,
+            const FNativeGraph *NativeGraph) {
+  UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+  Builder->BuildWeapon();
+  if (Builder->IsBuildPending()) {
+    FlushAsyncLoading();
+  }
+
+  const int32 NumBuilt = Builder->GetSpawnedAttachments().Num();
+  Builder->ClearWeapon();
+
+  if (NativeGraph && NumBuilt != FNativeGraph::NumParts) {
+    Test.AddError(FString::Printf(
+        TEXT("Native benchmark graph built %d of %d parts"), NumBuilt,
+        FNativeGraph::NumParts));
+    return false;
+  }
+  return true;
+}
+
+/** Weapon class from -AttachmentBenchWeapon=, AWeapon by default. */
+UClass *ResolveWeaponClass(FAutomationTestBase &Test) {
+  FString WeaponClassPath;
+  if (!FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchWeapon="),
+                     WeaponClassPath))
+    return AWeapon::StaticClass();
+
+  UClass *WeaponClass = LoadClass<AWeapon>(nullptr, *WeaponClassPath);
+  if (!WeaponClass) {
+    Test.AddError(FString::Printf(TEXT("Weapon class '%s' not found"),
+                                  *WeaponClassPath));
+  }
+  return WeaponClass;
+}
+
+/** Logs Report as one "AttachmentBenchmark:" line and writes it to
+ *  <AttachmentBenchOut>/<FileStem>.json. */
+void WriteReport(FAutomationTestBase &Test,
+                 const TSharedRef<FJsonObject> &Report,
+                 const FString &FileStem) {
+  FString Line;
+  FJsonSerializer::Serialize(
+      Report, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(
+                  &Line));
+  Test.AddInfo(FString::Printf(TEXT("AttachmentBenchmark: %s"), *Line));
+
+  FString OutDir = FPaths::AutomationDir() / TEXT("AttachmentSystem");
+  FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchOut="), OutDir);
+  const FString OutFile = OutDir / (FileStem + TEXT(".json"));
+  if (!FFileHelper::SaveStringToFile(Line, *OutFile)) {
+    Test.AddWarning(FString::Printf(TEXT("Could not write %s"), *OutFile));
+  }
+}
+
+/** Median game-thread time of one full world tick. */
+double MedianFrameMs(UWorld *World, const int32 NumFrames) {
+  TArray<double> Ms;
+  Ms.Reserve(NumFrames);
+  for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+    const double Start = FPlatformTime::Seconds();
+    World->Tick(LEVELTICK_All, 1.f / 60.f);
+    Ms.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+  }
+  return Percentile(MoveTemp(Ms), 0.5);
+}
+
+void FillMagazine(AMagazineAttachment *Magazine) {
+  while (Magazine->GetAmmoCount() < Magazine->GetCapacity() &&
+         Magazine->AddBullet(EBulletType::Standard_FMJ)) {
+  }
+}
+
+} // namespace AttachmentSystemBenchmark
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+    FAttachmentSystemLifecycleBenchmark, "AttachmentSystem.Benchmark.Lifecycle",
+    EAutomationTestFlags_ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+void FAttachmentSystemLifecycleBenchmark::GetTests(
+    TArray<FString> &OutBeautifiedNames,
+    TArray<FString> &OutTestCommands) const {
+  // Cold searches the graph on every build, Cached replays the stored plan
+  OutBeautifiedNames.Add(TEXT("Cold"));
+  OutTestCommands.Add(TEXT("Cold"));
+  OutBeautifiedNames.Add(TEXT("Cached"));
+  OutTestCommands.Add(TEXT("Cached"));
+}
+
+bool FAttachmentSystemLifecycleBenchmark::RunTest(const FString &Parameters) {
+  using namespace AttachmentSystemBenchmark;
+
+  const bool bUseBuildPlanCache = Parameters == TEXT("Cached");
+
+  int32 NumWeapons = 64;
+  int32 RoundsPerWeapon = 300;
+  FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchWeapons="),
+                NumWeapons);
+  FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchRounds="),
+                RoundsPerWeapon);
+  NumWeapons = FMath::Max(NumWeapons, 1);
+  RoundsPerWeapon = FMath::Max(RoundsPerWeapon, 0);
+
+  UClass *WeaponClass = ResolveWeaponClass(*this);
+  if (!WeaponClass)
+    return false;
+
+  FNativeGraph Graph;
+  const FNativeGraph *NativeGraph = nullptr;
+  if (WeaponClass == AWeapon::StaticClass()) {
+    if (!Graph.Initialize(*this))
+      return false;
+    NativeGraph = &Graph;
+  }
+
+  FScopedBenchmarkWorld BenchmarkWorld;
+  UWorld *World = BenchmarkWorld.World;
+
+  TArray<AWeapon *> Weapons;
+  for (int32 i = 0; i < NumWeapons; ++i) {
+    if (AWeapon *Weapon = SpawnBenchmarkWeapon(World, WeaponClass, NativeGraph,
+                                               bUseBuildPlanCache)) {
+      Weapons.Add(Weapon);
+    }
+  }
+  if (Weapons.Num() != NumWeapons) {
+    AddError(TEXT("Could not spawn benchmark weapons"));
+    return false;
+  }
+
+  if (!WarmUp(*this, Weapons[0], NativeGraph))
+    return false;
+
+  FPhaseSamples Build, Fire, Reload, Clear;
+
+  for (AWeapon *Weapon : Weapons) {
+    UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+
+    {
+      FAllocScope Allocs(Build.Allocations);
+      const double Start = FPlatformTime::Seconds();
+      Builder->BuildWeapon();
+      Build.Ms.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+    }
+    if (Builder->IsBuildPending()) {
+      AddError(TEXT("BuildWeapon is still streaming after warm-up"));
+      return false;
+    }
+
+    AMagazineAttachment *Magazine = Weapon->CurrentMagazine;
+    if (!Magazine || !Weapon->CurrentBarrel) {
+      AddError(FString::Printf(TEXT("%s built without a magazine and barrel"),
+                               *Weapon->GetName()));
+      return false;
+    }
+
+    double FireMs = 0.0;
+    double ReloadMs = 0.0;
+    int32 Fired = 0;
+    while (Fired < RoundsPerWeapon) {
+      if (Magazine->IsEmpty() && !Weapon->HasRoundChambered()) {
+        FAllocScope Allocs(Reload.Allocations);
+        const double Start = FPlatformTime::Seconds();
+        FillMagazine(Magazine);
+        ReloadMs += (FPlatformTime::Seconds() - Start) * 1000.0;
+      }
+
+      FAllocScope Allocs(Fire.Allocations);
+      const double Start = FPlatformTime::Seconds();
+      const int32 Rounds = Weapon->FireWeapon().Num();
+      FireMs += (FPlatformTime::Seconds() - Start) * 1000.0;
+      if (Rounds == 0) {
+        AddError(TEXT("FireWeapon fired nothing with a loaded magazine"));
+        return false;
+      }
+      ++Fired;
+    }
+    Fire.Ms.Add(FireMs);
+    Reload.Ms.Add(ReloadMs);
+
+    {
+      FAllocScope Allocs(Clear.Allocations);
+      const double Start = FPlatformTime::Seconds();
+      Builder->ClearWeapon();
+      Clear.Ms.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+    }
+  }
+
+  for (AWeapon *Weapon : Weapons) {
+    Weapon->Destroy();
+  }
+
+  TSharedRef<FJsonObject> Phases = MakeShared<FJsonObject>();
+  Phases->SetObjectField(TEXT("build"), PhaseToJson(Build, NumWeapons));
+  Phases->SetObjectField(TEXT("fire"), PhaseToJson(Fire, NumWeapons));
+  Phases->SetObjectField(TEXT("reload"), PhaseToJson(Reload, NumWeapons));
+  Phases->SetObjectField(TEXT("clear"), PhaseToJson(Clear, NumWeapons));
+
+  TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+  Report->SetStringField(TEXT("test"), GetTestFullName());
+  Report->SetStringField(TEXT("variant"), Parameters);
+  Report->SetStringField(TEXT("weaponClass"), WeaponClass->GetPathName());
+  Report->SetNumberField(TEXT("weapons"), NumWeapons);
+  Report->SetNumberField(TEXT("roundsPerWeapon"), RoundsPerWeapon);
+  Report->SetObjectField(TEXT("phases"), Phases);
+
+  WriteReport(*this, Report, TEXT("Lifecycle-") + Parameters);
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAttachmentSystemCompactBuildBenchmark,
+    "AttachmentSystem.Benchmark.CompactBuild",
+    EAutomationTestFlags_ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+bool FAttachmentSystemCompactBuildBenchmark::RunTest(
+    const FString &Parameters) {
+  using namespace AttachmentSystemBenchmark;
+
+  int32 NumWeapons = 64;
+  int32 NumFrames = 120;
+  FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchWeapons="),
+                NumWeapons);
+  FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchFrames="),
+                NumFrames);
+  NumWeapons = FMath::Max(NumWeapons, 1);
+  NumFrames = FMath::Max(NumFrames, 1);
+
+  UClass *WeaponClass = ResolveWeaponClass(*this);
+  if (!WeaponClass)
+    return false;
+
+  FNativeGraph Graph;
+  const FNativeGraph *NativeGraph = nullptr;
+  if (WeaponClass == AWeapon::StaticClass()) {
+    if (!Graph.Initialize(*this))
+      return false;
+    NativeGraph = &Graph;
+  }
+
+  FScopedBenchmarkWorld BenchmarkWorld;
+  UWorld *World = BenchmarkWorld.World;
+
+  TArray<AWeapon *> Weapons;
+  for (int32 i = 0; i < NumWeapons; ++i) {
+    if (AWeapon *Weapon =
+            SpawnBenchmarkWeapon(World, WeaponClass, NativeGraph, false)) {
+      Weapons.Add(Weapon);
+    }
+  }
+  if (Weapons.Num() != NumWeapons) {
+    AddError(TEXT("Could not spawn benchmark weapons"));
+    return false;
+  }
+
+  if (!WarmUp(*this, Weapons[0], NativeGraph))
+    return false;
+
+  // Weapons without parts: what every mode below is measured against
+  const double EmptyFrameMs = MedianFrameMs(World, NumFrames);
+
+  TSharedRef<FJsonObject> Modes = MakeShared<FJsonObject>();
+  for (const bool bCompact : {false, true}) {
+    FWeaponBuildFootprint Total;
+
+    for (AWeapon *Weapon : Weapons) {
+      UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+      Builder->SetCompactBuild(bCompact);
+      Builder->BuildWeapon();
+      if (Builder->IsBuildPending()) {
+        FlushAsyncLoading();
+      }
+      if (Builder->IsBuildPending()) {
+        AddError(TEXT("BuildWeapon is still streaming after a flush"));
+        return false;
+      }
+
+      const FWeaponBuildFootprint Footprint = Builder->GetBuildFootprint();
+      Total.ReplicatedActors += Footprint.ReplicatedActors;
+      Total.TickFunctions += Footprint.TickFunctions;
+      Total.MeshComponents += Footprint.MeshComponents;
+      Total.StaticMeshComponents += Footprint.StaticMeshComponents;
+      Total.DrawSections += Footprint.DrawSections;
+    }
+
+    const double FrameMs = MedianFrameMs(World, NumFrames);
+
+    const double PerWeapon = 1.0 / NumWeapons;
+    TSharedRef<FJsonObject> Mode = MakeShared<FJsonObject>();
+    Mode->SetNumberField(TEXT("replicatedActors"),
+                         Total.ReplicatedActors * PerWeapon);
+    Mode->SetNumberField(TEXT("tickFunctions"),
+                         Total.TickFunctions * PerWeapon);
+    Mode->SetNumberField(TEXT("meshComponents"),
+                         Total.MeshComponents * PerWeapon);
+    Mode->SetNumberField(TEXT("staticMeshComponents"),
+                         Total.StaticMeshComponents * PerWeapon);
+    Mode->SetNumberField(TEXT("drawSections"), Total.DrawSections * PerWeapon);
+    Mode->SetNumberField(TEXT("frameMs"), FrameMs);
+    Mode->SetNumberField(TEXT("tickMsPerWeapon"),
+                         FMath::Max(FrameMs - EmptyFrameMs, 0.0) * PerWeapon);
+    Modes->SetObjectField(bCompact ? TEXT("compact") : TEXT("actorPerPart"),
+                          Mode);
+
+    for (AWeapon *Weapon : Weapons) {
+      Weapon->GetWeaponBuilder()->ClearWeapon();
+    }
+  }
+
+  for (AWeapon *Weapon : Weapons) {
+    Weapon->Destroy();
+  }
+
+  TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+  Report->SetStringField(TEXT("test"), GetTestFullName());
+  Report->SetStringField(TEXT("weaponClass"), WeaponClass->GetPathName());
+  Report->SetNumberField(TEXT("weapons"), NumWeapons);
+  Report->SetNumberField(TEXT("frames"), NumFrames);
+  Report->SetNumberField(TEXT("emptyFrameMs"), EmptyFrameMs);
+  Report->SetObjectField(TEXT("modes"), Modes);
+
+  WriteReport(*this, Report, TEXT("CompactBuild"));
+  return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/WeaponBuilderComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "Misc/AttachmentSocketMapping.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Tests/AttachmentSystemBenchmarkParts.h"
+#include "UObject/StrongObjectPtr.h"
+
+/**
+ * Test world and native part graph shared by the AttachmentSystem
+ * automation tests (benchmarks and builder tests).
+ */
+namespace AttachmentSystemBenchmark {
+
+/** Game world without a viewport or net driver, torn down on scope exit. */
+struct FScopedBenchmarkWorld {
+  FScopedBenchmarkWorld() {
+    World = UWorld::CreateWorld(EWorldType::Game, false,
+                                TEXT("AttachmentSystemBenchmark"));
+    FWorldContext &Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+  }
+
+  ~FScopedBenchmarkWorld() {
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+  }
+
+  UWorld *World = nullptr;
+};
+
+/**
+ * Definitions and sockets of the native part graph. While alive, the parts'
+ * class defaults point at a transient definition table, so every spawned
+ * part resolves its row (mesh, category, rail flag) like a content part.
+ */
+struct FNativeGraph {
+  static constexpr int32 NumParts = 8;
+
+  ~FNativeGraph() {
+    for (UClass *PartClass : PartClasses) {
+      GetMutableDefault<AAttachment>(PartClass)->AttachmentDataTable = nullptr;
+    }
+  }
+
+  bool Initialize(FAutomationTestBase &Test) {
+    struct FPart {
+      UClass *Class;
+      EAttachmentCategory Category;
+      bool bUseRail;
+    };
+    const FPart Parts[] = {
+        {ABenchmarkReceiverAttachment::StaticClass(),
+         EAttachmentCategory::UpperReceiver, false},
+        {ABenchmarkBarrelAttachment::StaticClass(), EAttachmentCategory::Barrel,
+         false},
+        {ABenchmarkMuzzleAttachment::StaticClass(),
+         EAttachmentCategory::MuzzleDevice, false},
+        {ABenchmarkMagazineAttachment::StaticClass(),
+         EAttachmentCategory::Magazine, false},
+        {ABenchmarkStockAttachment::StaticClass(), EAttachmentCategory::Stock,
+         false},
+        {ABenchmarkRailAttachment::StaticClass(), EAttachmentCategory::Rail,
+         false},
+        {ABenchmarkOpticAttachment::StaticClass(), EAttachmentCategory::Optic,
+         true},
+        {ABenchmarkForegripAttachment::StaticClass(),
+         EAttachmentCategory::Foregrip, true}};
+    static_assert(UE_ARRAY_COUNT(Parts) == NumParts);
+
+    FString MeshPath = TEXT("/Engine/EngineMeshes/SkeletalCube.SkeletalCube");
+    FParse::Value(FCommandLine::Get(), TEXT("AttachmentBenchMesh="), MeshPath);
+    USkeletalMesh *Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
+    if (!Mesh || Mesh->GetRefSkeleton().GetRawBoneNum() == 0) {
+      Test.AddError(FString::Printf(
+          TEXT("Benchmark part mesh '%s' not found or has no bones"),
+          *MeshPath));
+      return false;
+    }
+    // Bones count as sockets: every category attaches at the root bone
+    const FName Socket = Mesh->GetRefSkeleton().GetBoneName(0);
+
+    Definitions.Reset(NewObject<UDataTable>());
+    Definitions->RowStruct = FAttachmentInfo::StaticStruct();
+    Sockets.Reset(NewObject<UAttachmentSocketMapping>());
+
+    for (const FPart &Part : Parts) {
+      AAttachment *Defaults = GetMutableDefault<AAttachment>(Part.Class);
+
+      FAttachmentInfo Row;
+      Row.Display_Name = Defaults->ID;
+      Row.Mesh = Mesh;
+      Row.Category = Part.Category;
+      Row.bUseRail = Part.bUseRail;
+      Row.Size = Defaults->Size;
+      Row.MagazineCapacity =
+          Part.Category == EAttachmentCategory::Magazine ? 30 : 0;
+      Definitions->AddRow(Defaults->ID, Row);
+
+      Sockets->SocketOverrides.Add(Part.Category, Socket);
+      Defaults->AttachmentDataTable = Definitions.Get();
+      PartClasses.Add(Part.Class);
+    }
+    return true;
+  }
+
+  void Apply(UWeaponBuilderComponent *Builder) const {
+    Builder->SetBaseAttachments(
+        {ABenchmarkReceiverAttachment::StaticClass()});
+    Builder->SocketMapping = Sockets.Get();
+  }
+
+  TStrongObjectPtr<UDataTable> Definitions;
+  TStrongObjectPtr<UAttachmentSocketMapping> Sockets;
+  TArray<UClass *> PartClasses;
+};
+
+} // namespace AttachmentSystemBenchmark
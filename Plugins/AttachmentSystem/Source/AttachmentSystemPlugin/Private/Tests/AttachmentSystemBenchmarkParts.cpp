@@ -0,0 +1,68 @@
+#include "Tests/AttachmentSystemBenchmarkParts.h"
+
+#include "Components/SplineComponent.h"
+
+namespace {
+void AddLink(AAttachment *Parent, TSubclassOf<AAttachment> ChildClass) {
+  Parent->ChildrenLinks.AddDefaulted_GetRef().ChildClasses.Add(ChildClass);
+}
+} // namespace
+
+ABenchmarkReceiverAttachment::ABenchmarkReceiverAttachment() {
+  ID = TEXT("Benchmark_Receiver");
+  AddLink(this, ABenchmarkBarrelAttachment::StaticClass());
+  AddLink(this, ABenchmarkMagazineAttachment::StaticClass());
+  AddLink(this, ABenchmarkStockAttachment::StaticClass());
+  AddLink(this, ABenchmarkRailAttachment::StaticClass());
+}
+
+ABenchmarkBarrelAttachment::ABenchmarkBarrelAttachment() {
+  ID = TEXT("Benchmark_Barrel");
+  AddLink(this, ABenchmarkMuzzleAttachment::StaticClass());
+}
+
+ABenchmarkMuzzleAttachment::ABenchmarkMuzzleAttachment() {
+  ID = TEXT("Benchmark_Muzzle");
+}
+
+ABenchmarkMagazineAttachment::ABenchmarkMagazineAttachment() {
+  ID = TEXT("Benchmark_Magazine");
+}
+
+ABenchmarkStockAttachment::ABenchmarkStockAttachment() {
+  ID = TEXT("Benchmark_Stock");
+}
+
+ABenchmarkRailAttachment::ABenchmarkRailAttachment() {
+  ID = TEXT("Benchmark_Rail");
+  // Long enough that parts the size of the benchmark mesh fit side by side:
+  // slots near the other parts are rejected by the broadphase, the rest go
+  // to the physics probe
+  RailSpline->SetLocationAtSplinePoint(1, FVector(1000.f, 0.f, 0.f),
+                                       ESplineCoordinateSpace::Local);
+  // Both rail parts in one link: the second is placed around the first
+  FAttachmentLink &RailLink = ChildrenLinks.AddDefaulted_GetRef();
+  RailLink.ChildClasses.Add(ABenchmarkOpticAttachment::StaticClass());
+  RailLink.ChildClasses.Add(ABenchmarkForegripAttachment::StaticClass());
+}
+
+ABenchmarkOpticAttachment::ABenchmarkOpticAttachment() {
+  ID = TEXT("Benchmark_Optic");
+  Size = 3;
+}
+
+ABenchmarkForegripAttachment::ABenchmarkForegripAttachment() {
+  ID = TEXT("Benchmark_Foregrip");
+  Size = 2;
+}
+
+int32 UBenchmarkCountingBehavior::NumTicks = 0;
+
+UBenchmarkCountingBehavior::UBenchmarkCountingBehavior() {
+  bTickBehavior = true;
+}
+
+void UBenchmarkCountingBehavior::TickBehavior(const float DeltaTime) {
+  Super::TickBehavior(DeltaTime);
+  ++NumTicks;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Actors/BarrelAttachment.h"
+#include "Actors/MagazineAttachment.h"
+#include "Actors/RailAttachment.h"
+#include "Components/AttachmentBehaviorComponent.h"
+#include "AttachmentSystemBenchmarkParts.generated.h"
+
+/**
+ * Native attachment graph used by the AttachmentSystem.Benchmark tests when
+ * no weapon class is given:
+ *
+ *   Receiver ─┬─ Barrel ── Muzzle
+ *             ├─ Magazine
+ *             ├─ Stock
+ *             └─ Rail ─┬─ Optic    (rail, 3 slots)
+ *                      └─ Foregrip (rail, 2 slots)
+ *
+ * Each part's ID names its row; the benchmark fills AttachmentDataTable with
+ * a transient definition table before spawning, so the parts resolve real
+ * definitions (category, mesh, rail flag) like content parts do.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkReceiverAttachment : public AAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkReceiverAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkBarrelAttachment : public ABarrelAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkBarrelAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkMuzzleAttachment : public AAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkMuzzleAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkMagazineAttachment : public AMagazineAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkMagazineAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkStockAttachment : public AAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkStockAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkRailAttachment : public ARailAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkRailAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkOpticAttachment : public AAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkOpticAttachment();
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class ABenchmarkForegripAttachment : public AAttachment {
+  GENERATED_BODY()
+
+public:
+  ABenchmarkForegripAttachment();
+};
+
+/** Ticking behaviour that counts its calls, for the builder tests. */
+UCLASS(NotBlueprintable, HideDropdown)
+class UBenchmarkCountingBehavior : public UAttachmentBehaviorComponent {
+  GENERATED_BODY()
+
+public:
+  UBenchmarkCountingBehavior();
+
+  virtual void TickBehavior(float DeltaTime) override;
+
+  /** TickBehavior calls across all instances. */
+  static int32 NumTicks;
+};
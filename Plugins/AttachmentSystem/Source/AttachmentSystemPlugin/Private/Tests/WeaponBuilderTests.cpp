@@ -0,0 +1,196 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/Attachment.h"
+#include "Actors/Weapon.h"
+#include "Components/WeaponBuilderComponent.h"
+#include "Misc/ScopeExit.h"
+#include "Subsystems/AttachmentTickSubsystem.h"
+#include "Subsystems/WeaponBuildPlanCache.h"
+#include "Tests/AttachmentSystemBenchmarkGraph.h"
+#include "Tests/AttachmentSystemBenchmarkParts.h"
+
+/**
+ * Builder behavior on the native part graph (AttachmentSystemBenchmarkParts.h).
+ *
+ *   -ExecCmds="Automation RunTests AttachmentSystem.Builder; Quit"
+ */
+namespace AttachmentSystemBuilderTests {
+
+struct FPartPose {
+  UClass *Class = nullptr;
+  FTransform World;
+  FName AttachSocket;
+  const UClass *AttachParentClass = nullptr;
+};
+
+/** World transform and attachment of every built part, in build order. */
+TArray<FPartPose> CapturePoses(UWeaponBuilderComponent *Builder) {
+  TArray<FPartPose> Poses;
+  for (AAttachment *Attachment : Builder->GetSpawnedAttachments()) {
+    const USceneComponent *Mesh = Attachment->GetMeshComponent();
+    if (!Mesh)
+      continue;
+
+    FPartPose &Pose = Poses.AddDefaulted_GetRef();
+    Pose.Class = Attachment->GetClass();
+    Pose.World = Mesh->GetComponentTransform();
+    Pose.AttachSocket = Mesh->GetAttachSocketName();
+    if (const USceneComponent *Parent = Mesh->GetAttachParent()) {
+      Pose.AttachParentClass = Parent->GetOwner()->GetClass();
+    }
+  }
+  return Poses;
+}
+
+bool BuildNow(FAutomationTestBase &Test, UWeaponBuilderComponent *Builder) {
+  Builder->BuildWeapon();
+  if (Builder->IsBuildPending()) {
+    FlushAsyncLoading();
+  }
+  if (Builder->IsBuildPending()) {
+    Test.AddError(TEXT("BuildWeapon is still streaming after a flush"));
+    return false;
+  }
+  return true;
+}
+
+} // namespace AttachmentSystemBuilderTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FWeaponBuilderCachedBuildMatchesColdTest,
+    "AttachmentSystem.Builder.CachedBuildMatchesCold",
+    EAutomationTestFlags_ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+bool FWeaponBuilderCachedBuildMatchesColdTest::RunTest(
+    const FString &Parameters) {
+  using namespace AttachmentSystemBenchmark;
+  using namespace AttachmentSystemBuilderTests;
+
+  FNativeGraph Graph;
+  if (!Graph.Initialize(*this))
+    return false;
+
+  FScopedBenchmarkWorld TestWorld;
+  AWeapon *Weapon = TestWorld.World->SpawnActor<AWeapon>();
+  if (!TestNotNull(TEXT("Weapon"), Weapon) ||
+      !TestNotNull(TEXT("Weapon builder"), Weapon->GetWeaponBuilder()))
+    return false;
+
+  UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+  Graph.Apply(Builder);
+  Builder->SetUseBuildPlanCache(true);
+
+  // Cold: the socket mapping is new, so no plan exists yet
+  if (!BuildNow(*this, Builder))
+    return false;
+  const TArray<FPartPose> Cold = CapturePoses(Builder);
+  TestEqual(TEXT("Cold build part count"), Cold.Num(), FNativeGraph::NumParts);
+  Builder->ClearWeapon();
+
+  UWeaponBuildPlanCache *PlanCache =
+      GEngine->GetEngineSubsystem<UWeaponBuildPlanCache>();
+  const TSubclassOf<AAttachment> Roots[] = {
+      ABenchmarkReceiverAttachment::StaticClass()};
+  if (!TestNotNull(TEXT("Recorded plan"),
+                   PlanCache->FindPlan(Roots, Graph.Sockets.Get())))
+    return false;
+
+  // Cached: replays the recorded plan
+  if (!BuildNow(*this, Builder))
+    return false;
+  const TArray<FPartPose> Cached = CapturePoses(Builder);
+
+  if (TestEqual(TEXT("Cached build part count"), Cached.Num(), Cold.Num())) {
+    for (int32 i = 0; i < Cold.Num(); ++i) {
+      const FString Part = Cold[i].Class->GetName();
+      TestTrue(Part + TEXT(" class"), Cached[i].Class == Cold[i].Class);
+      TestTrue(Part + TEXT(" transform"),
+               Cached[i].World.Equals(Cold[i].World, 1.e-3f));
+      TestEqual(Part + TEXT(" socket"), Cached[i].AttachSocket,
+                Cold[i].AttachSocket);
+      TestTrue(Part + TEXT(" parent"),
+               Cached[i].AttachParentClass == Cold[i].AttachParentClass);
+    }
+  }
+
+  Builder->ClearWeapon();
+  Weapon->Destroy();
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FWeaponBuilderBehaviorsTickThroughSubsystemTest,
+    "AttachmentSystem.Builder.BehaviorsTickThroughSubsystem",
+    EAutomationTestFlags_ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+bool FWeaponBuilderBehaviorsTickThroughSubsystemTest::RunTest(
+    const FString &Parameters) {
+  using namespace AttachmentSystemBenchmark;
+  using namespace AttachmentSystemBuilderTests;
+
+  FNativeGraph Graph;
+  if (!Graph.Initialize(*this))
+    return false;
+
+  // The optic carries a ticking behaviour for this test only
+  AAttachment *OpticDefaults = GetMutableDefault<ABenchmarkOpticAttachment>();
+  OpticDefaults->BehaviorClass = UBenchmarkCountingBehavior::StaticClass();
+  ON_SCOPE_EXIT { OpticDefaults->BehaviorClass = nullptr; };
+
+  FScopedBenchmarkWorld TestWorld;
+  UAttachmentTickSubsystem *TickSubsystem =
+      TestWorld.World->GetSubsystem<UAttachmentTickSubsystem>();
+  AWeapon *Weapon = TestWorld.World->SpawnActor<AWeapon>();
+  if (!TestNotNull(TEXT("Tick subsystem"), TickSubsystem) ||
+      !TestNotNull(TEXT("Weapon"), Weapon) ||
+      !TestNotNull(TEXT("Weapon builder"), Weapon->GetWeaponBuilder()))
+    return false;
+
+  UWeaponBuilderComponent *Builder = Weapon->GetWeaponBuilder();
+  Graph.Apply(Builder);
+
+  const int32 BaselineTicks = TickSubsystem->GetNumRegisteredTicks();
+  if (!BuildNow(*this, Builder))
+    return false;
+
+  const TArray<AAttachment *> Optics =
+      Builder->GetAttachmentsInCategory(EAttachmentCategory::Optic);
+  if (!TestEqual(TEXT("Built optics"), Optics.Num(), 1))
+    return false;
+  TestNotNull(TEXT("Optic behavior"),
+              Optics[0]->FindComponentByClass<UBenchmarkCountingBehavior>());
+  TestEqual(TEXT("Registered ticks after build"),
+            TickSubsystem->GetNumRegisteredTicks(), BaselineTicks + 1);
+
+  // Behaviours tick with the world, through the subsystem
+  constexpr int32 NumFrames = 3;
+  UBenchmarkCountingBehavior::NumTicks = 0;
+  for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+    TestWorld.World->Tick(LEVELTICK_All, 1.f / 60.f);
+  }
+  TestEqual(TEXT("Behavior ticks while built"),
+            UBenchmarkCountingBehavior::NumTicks, NumFrames);
+
+  // And stop once the weapon is cleared
+  Builder->ClearWeapon();
+  TestEqual(TEXT("Registered ticks after clear"),
+            TickSubsystem->GetNumRegisteredTicks(), BaselineTicks);
+  TestNull(TEXT("Optic behavior after clear"),
+           Optics[0]->FindComponentByClass<UBenchmarkCountingBehavior>());
+
+  UBenchmarkCountingBehavior::NumTicks = 0;
+  for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+    TestWorld.World->Tick(LEVELTICK_All, 1.f / 60.f);
+  }
+  TestEqual(TEXT("Behavior ticks after clear"),
+            UBenchmarkCountingBehavior::NumTicks, 0);
+
+  Weapon->Destroy();
+  return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
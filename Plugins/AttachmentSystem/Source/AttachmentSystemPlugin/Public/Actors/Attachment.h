@@ -3,10 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/AmmoOpBuffer.h"
 #include "Misc/AttachmentSystemTypes.h"
 #include "Attachment.generated.h"
 
 class UBoxComponent;
+class UStaticMeshComponent;
+class AAttachment;
+class AWeapon;
+class UAttachmentBehaviorComponent;
+
+/** Fired when an attachment's runtime durability changes (old, new). */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnAttachmentDurabilityChanged,
+                                       AAttachment *, float, float);
 
 /**
  * @brief Base class for all weapon attachments.
@@ -14,6 +23,7 @@ class UBoxComponent;
  * - Represents modular parts (scopes, stocks, barrels, etc.).
  * - Handles DataTable loading, mesh setup, and runtime state like durability.
  * - Provides getters for UI/tooltips and stat modifiers.
+ * - Does not tick; per-frame work goes through UAttachmentTickSubsystem.
  */
 UCLASS(Blueprintable)
 class ATTACHMENTSYSTEMPLUGIN_API AAttachment : public AActor {
@@ -30,13 +40,16 @@ public:
   /** Called after all components have been initialized. */
   virtual void PostInitializeComponents() override;
 
-  /** Called every frame if ticking is enabled. */
-  virtual void Tick(float DeltaTime) override;
-
 protected:
   /** Called when the game starts or when this actor is spawned. */
   virtual void BeginPlay() override;
 
+  /** Client: a replicated attach, detach or pool release changes what the
+   *  weapon's merged mesh shows. */
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  virtual void OnRep_AttachmentReplication() override;
+  virtual void OnRep_Owner() override;
+
 public:
   /* =============================
    * Visual Representation
@@ -46,6 +59,21 @@ public:
   UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
   TObjectPtr<USkeletalMeshComponent> MeshComponent;
 
+  /**
+   * Draws the row's StaticMesh when the skeletal mesh has no animated bones
+   * (created on first use). MeshComponent then stays as an invisible,
+   * non-skinned socket/collision host.
+   */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient)
+  TObjectPtr<UStaticMeshComponent> StaticMeshComponent;
+
+  /** True while the static fallback is drawn instead of MeshComponent. */
+  UFUNCTION(BlueprintPure, Category = "Attachment")
+  bool IsRenderedAsStatic() const;
+
+  /** True if Mesh needs skinning: more than a root bone, or morph targets. */
+  static bool HasAnimatedBones(const USkeletalMesh *Mesh);
+
   /* =============================
    * Graph / Hierarchy
    * ============================= */
@@ -71,9 +99,12 @@ public:
             meta = (AllowPrivateAccess = "true", ExposeOnSpawn = "true"))
   FName ID;
 
-  /** Static definition loaded from DataTable (mesh, stats, description). */
-  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attachment",
-            meta = (AllowPrivateAccess = "true"))
+  /** Per-instance definition, kept for existing Blueprints and placed
+   *  instances. Reads go through GetAttachmentInfo: the shared DataTable row
+   *  wins once resolved, these values are used only while it is not (same
+   *  precedence as when the row was copied in here). */
+  UPROPERTY(EditAnywhere, BlueprintGetter = GetAttachmentInfo,
+            Category = "Attachment", meta = (AllowPrivateAccess = "true"))
   FAttachmentInfo AttachmentInfo;
 
   /** Runtime state (e.g., current durability, dynamic values). */
@@ -85,8 +116,36 @@ public:
   UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attachment")
   TObjectPtr<UDataTable> AttachmentDataTable;
 
-  /** Load and apply DataTable info into this attachment (mesh, stats, etc.). */
-  void LoadAttachmentInfo();
+  /** Keep this part as a live actor in compact builds (see
+   *  UWeaponBuilderComponent::bCompactBuild). */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attachment")
+  bool bKeepActorInCompactBuild = false;
+
+  /** Behaviour the builder adds to this part while it is built into a
+   *  weapon (see UWeaponBuilderComponent::AddBehaviorComponent). */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attachment")
+  TSubclassOf<UAttachmentBehaviorComponent> BehaviorClass;
+
+  /** True if gameplay needs this part as an actor (RPCs, replicated state,
+   *  placement, behaviours). Other parts may be reduced to a mesh in compact
+   *  builds. */
+  virtual bool RequiresActor() const;
+
+  /** Resolve the shared DataTable definition and apply it (mesh, durability,
+   *  collision). The row itself is never copied into the actor. */
+  virtual void LoadAttachmentInfo();
+
+  /** Logs per-instance memory and per-build copy cost of a copied row vs
+   *  the shared definition. */
+  UFUNCTION(BlueprintCallable, CallInEditor, Category = "Attachment|Debug")
+  void RunDefinitionSharingTest();
+
+  /**
+   * Returns this attachment to a clean state before it goes back to the
+   * attachment pool: detached, no mesh, no child instances, default runtime
+   * state. Subclasses reset their own runtime data.
+   */
+  virtual void ResetForPool();
 
   /* =============================
    * Getters
@@ -104,43 +163,108 @@ public:
     return AttachmentCurrentState.Durability;
   }
 
-  /** Returns full static definition (from DataTable). */
+  /** Sets runtime durability and notifies OnDurabilityChanged. Use this
+   *  instead of writing AttachmentCurrentState directly so the owning
+   *  weapon's aggregate stays in sync. */
+  UFUNCTION(BlueprintCallable, Category = "Attachment|Stats")
+  void SetDurability(float NewDurability);
+
+  /** Listeners of durability changes (the owning weapon). */
+  FOnAttachmentDurabilityChanged OnDurabilityChanged;
+
+  /* =============================
+   * Ammo Command Buffer
+   * ============================= */
+
+  /**
+   * Seconds between client flushes of recorded ammo ops; 0 flushes once
+   * at the start of the next frame.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attachment|Network",
+            meta = (ClampMin = "0.0"))
+  float AmmoOpFlushInterval = 0.f;
+
+  /** Sends every recorded ammo op now (client). */
+  UFUNCTION(BlueprintCallable, Category = "Attachment|Network")
+  void FlushAmmoOps();
+
+  /** Applies a client's recorded ammo ops in order. */
+  UFUNCTION(Server, Reliable)
+  void Server_ApplyAmmoOps(const TArray<FAmmoOp> &Ops);
+
+  /** Ops recorded / RPCs sent by this client (reliable-buffer pressure). */
+  int32 GetNumAmmoOpsRecorded() const {
+    return PendingAmmoOps.GetNumRecorded();
+  }
+  int32 GetNumAmmoOpRpcsSent() const { return NumAmmoOpRpcsSent; }
+
+  /** Returns full static definition (shared DataTable row, or the
+   *  instance's AttachmentInfo if no row is resolved). */
   UFUNCTION(BlueprintPure, Category = "Attachment")
-  FORCEINLINE FAttachmentInfo GetAttachmentInfo() const {
-    return AttachmentInfo;
+  FORCEINLINE const FAttachmentInfo &GetAttachmentInfo() const {
+    return AttachmentDefinition.IsValid() ? *AttachmentDefinition
+                                          : AttachmentInfo;
   }
 
   /** Returns this attachment's category (optic, stock, barrel, etc.). */
   UFUNCTION(BlueprintPure, Category = "Attachment")
   FORCEINLINE EAttachmentCategory GetAttachmentCategory() const {
-    return AttachmentInfo.Category;
+    return GetAttachmentInfo().Category;
   }
 
   /** Returns how many slots this attachment occupies. */
   UFUNCTION(BlueprintPure, Category = "Attachment")
-  FORCEINLINE int32 GetSize() const { return AttachmentInfo.Size; }
+  FORCEINLINE int32 GetSize() const { return GetAttachmentInfo().Size; }
 
   /** Returns the starting slot index. */
   UFUNCTION(BlueprintPure, Category = "Attachment")
   FORCEINLINE int32 GetAttachmentStartSlot() const {
-    return AttachmentInfo.StartSlot;
+    return GetAttachmentInfo().StartSlot;
   }
 
   /** Returns short display name (used in UI). */
   UFUNCTION(BlueprintPure, Category = "Attachment")
   FORCEINLINE FName GetAttachmentDisplayName() const {
-    return AttachmentInfo.Display_Name;
+    return GetAttachmentInfo().Display_Name;
   }
 
   /** Returns description text (used in UI/tooltips). */
   UFUNCTION(BlueprintPure, Category = "Attachment")
-  FORCEINLINE FText GetAttachmentDisplayDescription() const {
-    return AttachmentInfo.Display_Description;
+  FORCEINLINE const FText &GetAttachmentDisplayDescription() const {
+    return GetAttachmentInfo().Display_Description;
   }
 
   /** Returns stat modifiers this attachment applies. */
   UFUNCTION(BlueprintPure, Category = "Attachment")
-  FORCEINLINE TArray<FStatModifier> GetStatModifiers() const {
-    return AttachmentInfo.Modifiers;
+  FORCEINLINE const TArray<FStatModifier> &GetStatModifiers() const {
+    return GetAttachmentInfo().Modifiers;
   }
+
+protected:
+  /** Client: records an op and schedules a flush. */
+  void QueueAmmoOp(EAmmoOpType Op, EBulletType BulletType = EBulletType::None,
+                   int32 Count = 1);
+
+  /** Server: applies one validated op. Returns false if this attachment
+   *  does not handle the op, which stops the rest of the batch. */
+  virtual bool ApplyAmmoOp(const FAmmoOp &Op) { return false; }
+
+private:
+  FAmmoOpBuffer PendingAmmoOps;
+  FTimerHandle AmmoOpFlushHandle;
+  int32 NumAmmoOpRpcsSent = 0;
+
+  /** Client: weapon whose merged mesh last included this attachment. */
+  TWeakObjectPtr<AWeapon> BakedIntoWeapon;
+
+  /** Client: asks the previous and the current owning weapon to rebake
+   *  their merged mesh (the server rebakes from the build itself). */
+  void RequestWeaponRebake();
+
+  /** Shows StaticMeshComponent or MeshComponent for the loaded row. */
+  void ApplyStaticFallback(const FAttachmentInfo &AttachmentInfo);
+
+  /** Immutable definition shared by every instance of the same row
+   *  (see UAttachmentDefinitionStore). */
+  TSharedPtr<const FAttachmentInfo> AttachmentDefinition;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Attachment.h"
+#include "Misc/PackedRoundSequence.h"
 #include "BarrelAttachment.generated.h"
 
 UCLASS()
@@ -13,34 +14,43 @@ class ATTACHMENTSYSTEMPLUGIN_API ABarrelAttachment : public AAttachment {
 public:
   ABarrelAttachment();
 
-  /** Set chambered round when racking or reloading. */
+  /** Set chambered round when racking or reloading. On clients this is
+   *  recorded as ammo ops and sent with the next flush. */
   UFUNCTION(BlueprintCallable, Category = "Barrel|Ammo")
   void SetChamberedRounds(const TArray<EBulletType> &NewRounds);
 
-  UFUNCTION(Server, Reliable)
-  void Server_SetChamberedRounds(const TArray<EBulletType> &NewRounds);
-
   UFUNCTION(BlueprintCallable, Category = "Barrel|Ammo")
   void ClearChamber();
 
-  UFUNCTION(Server, Reliable)
-  void Server_ClearChamber();
-
   UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Barrel|Ammo")
   TArray<EBulletType> GetChamberedRounds() const {
+    return ChamberedRounds.ToArray();
+  }
+
+  /** Chambered rounds without unpacking. */
+  const FPackedRoundSequence &GetChamberedRoundSequence() const {
     return ChamberedRounds;
   }
 
+  /** Empties the chamber before pooling. */
+  virtual void ResetForPool() override;
+
+  /** The chamber is replicated state, so barrels stay actors. */
+  virtual bool RequiresActor() const override { return true; }
+
   /** Quick check if chamber is occupied. */
   UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Barrel|Ammo")
   bool HasRoundChambered() const {
-    return ChamberedRounds.Num() > 0;
+    return !ChamberedRounds.IsEmpty();
   }
 
 protected:
-  /** Replicated chambered rounds (empty if none). */
+  /** ClearChamber / ChamberRounds from a client flush. */
+  virtual bool ApplyAmmoOp(const FAmmoOp &Op) override;
+
+  /** Replicated chambered rounds (empty if none), 3 bits per round. */
   UPROPERTY(ReplicatedUsing = OnRep_ChamberedRounds)
-  TArray<EBulletType> ChamberedRounds;
+  FPackedRoundSequence ChamberedRounds;
 
   UFUNCTION()
   void OnRep_ChamberedRounds();
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Attachment.h"
+#include "Misc/PackedRoundSequence.h"
+#include "Misc/ReplicatedMagazineContents.h"
+#include "ThirdParty/DynamicRingBuffer.h"
 #include "ThirdParty/RingBuffer.h"
 #include "MagazineAttachment.generated.h"
 
@@ -15,20 +18,18 @@ public:
   virtual void GetLifetimeReplicatedProps(
       TArray<class FLifetimeProperty> &OutLifetimeProps) const override;
 
-  /** Add a bullet of the given type to the magazine (returns true if added). */
+  /**
+   * Add a bullet of the given type to the magazine (returns true if added).
+   * On clients the request is recorded and sent with the next ammo-op flush.
+   */
   UFUNCTION(BlueprintCallable, Category = "Magazine")
   bool AddBullet(EBulletType BulletType);
 
-  UFUNCTION(Server, Reliable)
-  void Server_AddBullet(EBulletType BulletType);
-
-  /** Removes one bullet from the magazine and returns its type. */
+  /** Removes one bullet from the magazine and returns its type (None on
+   *  clients, where the request is recorded for the next flush). */
   UFUNCTION(BlueprintCallable, Category = "Magazine")
   EBulletType RemoveBullet();
 
-  UFUNCTION(Server, Reliable)
-  void Server_RemoveBullet();
-
   /** Gets the current number of bullets in the magazine. */
   UFUNCTION(BlueprintCallable, Category = "Magazine")
   int32 GetAmmoCount() const;
@@ -48,8 +49,14 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Magazine")
   void RemoveBullets(int32 n);
 
-  UFUNCTION(Server, Reliable)
-  void Server_RemoveBullets(int32 n);
+  /**
+   * Server-side bulk read: removes up to Count rounds in one block Get and
+   * appends them, in firing order, to OutBullets. ReplicatedAmmoCount is
+   * updated once.
+   *
+   * @return Number of rounds removed.
+   */
+  int32 DrainBullets(int32 Count, TArray<EBulletType> &OutBullets);
 
   UPROPERTY(ReplicatedUsing = OnRep_AmmoCount)
   int32 ReplicatedAmmoCount = 0;
@@ -57,18 +64,78 @@ public:
   UFUNCTION()
   void OnRep_AmmoCount();
 
+  /** Loaded rounds in firing order, available on clients too. */
+  UFUNCTION(BlueprintPure, Category = "Magazine")
+  TArray<EBulletType> GetLoadedRounds() const {
+    return ReplicatedContents.GetRounds().ToArray();
+  }
+
+  /** Bytes the last contents delta cost (server, for net profiling). */
+  UFUNCTION(BlueprintPure, Category = "Magazine|Debug")
+  int32 GetLastContentsDeltaBytes() const {
+    return ReplicatedContents.GetLastDeltaBytes();
+  }
+
+  /** Drains the magazine before pooling. */
+  virtual void ResetForPool() override;
+
+  /** Magazines hold replicated ammo, so they stay actors. */
+  virtual bool RequiresActor() const override { return true; }
+
+  /**
+   * Copies the loaded rounds, front first, into a packed sequence (3 bits
+   * per round, run-length for homogeneous ammo), e.g. to keep idle
+   * magazines in an inventory without a live actor per magazine.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Magazine")
+  FPackedRoundSequence ExportRounds();
+
+  /** Replaces the contents with a packed sequence (extra rounds dropped). */
+  UFUNCTION(BlueprintCallable, Category = "Magazine")
+  void ImportRounds(const FPackedRoundSequence &Rounds);
+
+  /** Loads the row, then sizes the bullet storage for it. */
+  virtual void LoadAttachmentInfo() override;
+
+  /** Magazine model; sets capacity unless the DataTable row overrides it. */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magazine")
+  EMagazineType MagazineType = EMagazineType::Magpul_MOE_30;
+
+  /** Nominal round count of a magazine model. */
+  UFUNCTION(BlueprintPure, Category = "Magazine")
+  static int32 GetCapacityForType(EMagazineType Type);
+
 protected:
   virtual void BeginPlay() override;
 
   UFUNCTION(BlueprintCallable, CallInEditor, Category = "Magazine|Debug")
   static void RunPerformanceTest();
 
+  /** Logs RPC count and payload bytes of a round-by-round reload sent as
+   *  individual RPCs vs one coalesced ammo-op flush. */
+  UFUNCTION(BlueprintCallable, CallInEditor, Category = "Magazine|Debug")
+  static void RunReloadSpamTest();
+
+  /** LoadRounds / RemoveRounds from a client flush. */
+  virtual bool ApplyAmmoOp(const FAmmoOp &Op) override;
+
+protected:
+  /** Round order for clients; delta-serialized (new rounds only). */
+  UPROPERTY(ReplicatedUsing = OnRep_Contents)
+  FReplicatedMagazineContents ReplicatedContents;
+
+  UFUNCTION()
+  void OnRep_Contents();
+
 private:
-  /** Capacity of the magazine (compile-time constant). */
-  static constexpr int32 MagazineCapacity = 30;
+  /** Capacity of the magazine (picked at spawn from row or type). */
+  int32 MagazineCapacity = 30;
+
+  /** Internal SPSC buffer storing bullet types, sized at runtime. */
+  Lomont::DynamicRingBuffer<EBulletType, uint32> BulletBuffer{30};
 
-  /** Internal buffer storing bullet types. */
-  Lomont::RingBuffer<MagazineCapacity, EBulletType, int32> BulletBuffer;
+  /** Re-sizes BulletBuffer, keeping as many loaded rounds as still fit. */
+  void ResizeStorage(int32 NewCapacity);
 
   /** Utility: log buffer contents without destroying data. */
   void LogBufferNonDestructive(const FString &Context);
@@ -42,9 +42,14 @@ public:
    * Runtime State
    * ============================= */
 
-  /** Bitmask representing slot occupancy (1 = taken, 0 = free). */
+  /** Bitmask representing slot occupancy (1 = taken, 0 = free).
+   *  Limits the usable rail to MaxSlots slots.
+   */
   uint64 OccupancyMask = 0;
 
+  /** Maximum number of slots addressable by OccupancyMask. */
+  static constexpr int32 MaxSlots = 64;
+
   /** Set of all attachments currently mounted to this rail. */
   UPROPERTY()
   TSet<AAttachment *> MountedAttachments;
@@ -75,6 +80,28 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Rail")
   int32 GetSlotFromDistance(float Distance) const;
 
+  /**
+   * Inverse of GetSlotFromDistance: the first distance along the spline that
+   * maps to the given slot index.
+   *
+   * @param SlotIndex  Slot index (0..NumSlots-1).
+   * @return           Distance along spline where that slot begins.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Rail")
+  float GetDistanceFromSlot(int32 SlotIndex) const;
+
+  /**
+   * Computes every start slot where an item of the given size fits, using only
+   * bit operations on OccupancyMask (no spline sampling, no physics).
+   *
+   * Bit i of the result is set when slots [i, i + ItemSize) are all inside the
+   * rail and currently free.
+   *
+   * @param ItemSize  Number of slots the item occupies.
+   * @return          Bitmask of valid start slots (bit 0 = slot 0).
+   */
+  uint64 GetFreeStartSlotMask(int32 ItemSize) const;
+
   /**
    * Places an attachment at its StartPosition (updates occupancy + attaches to
    * spline).
@@ -106,6 +133,12 @@ public:
    */
   FTransform GetSlotTransform(int32 SlotIndex) const;
 
+  /** Clears occupancy and mounted attachments before pooling. */
+  virtual void ResetForPool() override;
+
+  /** Rails track mounted parts and slots, so they stay actors. */
+  virtual bool RequiresActor() const override { return true; }
+
 private:
   /**
    * Utility to generate a bitmask for a contiguous slot range.
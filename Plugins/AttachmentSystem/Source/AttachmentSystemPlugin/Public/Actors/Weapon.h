@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Misc/AttachmentSystemTypes.h"
+#include "Misc/WeaponDurabilityTracker.h"
+#include "Misc/WeaponStatEngine.h"
 #include "Weapon.generated.h"
 
 class AMagazineAttachment;
@@ -28,10 +30,10 @@ class ATTACHMENTSYSTEMPLUGIN_API AWeapon : public AActor {
 
 public:
   AWeapon();
-  virtual void Tick(float DeltaTime) override;
 
 protected:
   virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
   virtual void GetLifetimeReplicatedProps(
       TArray<class FLifetimeProperty> &OutLifetimeProps) const override;
@@ -51,18 +53,48 @@ public:
   UFUNCTION()
   void HandleWeaponBuilt(const TArray<AAttachment *> &SpawnedAttachments);
 
+  /** Drops every active attachment before the builder releases them. */
+  UFUNCTION()
+  void HandleWeaponCleared();
+
+  /** Adds one attachment to the active set (stats + durability aggregate). */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Attachments")
+  void RegisterActiveAttachment(AAttachment *Attachment);
+
+  /** Removes one attachment from the active set. */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Attachments")
+  void UnregisterActiveAttachment(AAttachment *Attachment);
+
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Config")
   FWeaponInfo WeaponInfo;
 
   UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Weapon|Stats")
   FWeaponCurrentState WeaponCurrentState;
 
+  /** Aggregate attachment durability. O(1), no side effects. */
   UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Weapon|Stats")
   float GetWeaponDurability(
-      EWeaponDurabilityMode Mode = EWeaponDurabilityMode::Average);
+      EWeaponDurabilityMode Mode = EWeaponDurabilityMode::Average) const;
+
+  /** Final value of a stat: base + every active attachment's modifiers. */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Weapon|Stats")
+  float GetWeaponStat(EWeaponStat Stat) const;
+
+  /** Folds one attachment's modifiers in (only its stats are recomputed). */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
+  void AddAttachmentStats(AAttachment *Attachment);
 
+  /** Removes one attachment's modifiers (only its stats are recomputed). */
   UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
-  void ModifyDurability(float Delta);
+  void RemoveAttachmentStats(AAttachment *Attachment);
+
+  /** Re-applies WeaponInfo.BaseStats after editing them at runtime. */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
+  void RefreshBaseStats();
+
+  /** Re-bakes WeaponInfo.WearCoefficients after editing them at runtime. */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Wear")
+  void RefreshWearCoefficients();
   void StartFiring();
   void StopFiring();
   void OnShotFired();
@@ -70,10 +102,13 @@ public:
   /* =============================
    * Ammo / Attachments
    * ============================= */
-  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Ammo")
+  /** Set by the server build; replicated so clients read ammo state. */
+  UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly,
+            Category = "Weapon|Ammo")
   AMagazineAttachment *CurrentMagazine = nullptr;
 
-  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Ammo")
+  UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly,
+            Category = "Weapon|Ammo")
   ABarrelAttachment *CurrentBarrel = nullptr;
 
   UPROPERTY(BlueprintAssignable, Category = "Weapon|Ammo")
@@ -92,6 +127,25 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Weapon|Ammo")
   TArray<EBulletType> FireFromChamber();
 
+  /**
+   * Fires up to Count shots in one call: the chambered round, then the rest
+   * drawn from the magazine in a single block read, re-chambering the next
+   * round from the same read. OnWeaponFired is broadcast once and the
+   * magazine ammo count changes once.
+   *
+   * @param Count  Shots to fire (e.g. everything queued in a batch window).
+   * @return       Fired rounds in order (pellets of a shell are adjacent).
+   */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Ammo")
+  TArray<EBulletType> FireBurst(int32 Count);
+
+  /** Client batch window → server FireBurst, clamped to the rounds held. */
+  UFUNCTION(Server, Reliable, WithValidation)
+  void Server_FireBurst(int32 Count);
+
+  /** Upper bound on one batch's shot count accepted from a client. */
+  static constexpr int32 MaxShotsPerBatch = 1024;
+
   UFUNCTION(BlueprintCallable, Category = "Weapon|Ammo")
   bool TryChamberFromMagazine();
 
@@ -138,10 +192,62 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Weapon|Ammo")
   FORCEINLINE bool HasAmmo() const { return GetAmmoCount() > 0; }
 
+  /* =============================
+   * Detail / Significance
+   * ============================= */
+
+  /** Applies a render detail tier locally (small parts, merged view). Set
+   *  by UWeaponSignificanceSubsystem on every machine with a viewer. */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Detail")
+  void SetDetailTier(EWeaponDetailTier NewTier);
+
+  UFUNCTION(BlueprintPure, Category = "Weapon|Detail")
+  FORCEINLINE EWeaponDetailTier GetDetailTier() const { return DetailTier; }
+
+  FORCEINLINE UWeaponBuilderComponent *GetWeaponBuilder() const {
+    return WeaponBuilderComponent;
+  }
+
+  /** True if a local player controls the pawn or controller owning this
+   *  weapon. */
+  bool IsOwnedByLocalPlayer() const;
+
 private:
+  EWeaponDetailTier DetailTier = EWeaponDetailTier::Full;
+
+  /** Aggregated attachment stat modifiers. */
+  FWeaponStatEngine StatEngine;
+
+  /** Running durability aggregate of ActiveAttachments. */
+  FWeaponDurabilityTracker DurabilityTracker;
+
+  /** Starts/stops following an attachment's durability. */
+  void TrackAttachmentDurability(AAttachment *Attachment);
+  void UntrackAttachmentDurability(AAttachment *Attachment);
+
+  /** OnDurabilityChanged listener. */
+  void HandleAttachmentDurabilityChanged(AAttachment *Attachment,
+                                         float OldDurability,
+                                         float NewDurability);
+
   FTimerHandle BatchTimerHandle;
   int32 PendingShots = 0;
 
+  /** True while the looping batch timer runs (StartFiring/StopFiring). */
+  bool bBatchFiring = false;
+
+  /** Shots fired since the last batch, not yet applied as wear. */
+  int32 PendingWearShots = 0;
+
+  /** WeaponInfo.WearCoefficients, indexed by EAttachmentCategory. */
+  TArray<float> WearCoefficientTable;
+
+  /** Adds shots to PendingWearShots, arming a one-shot batch if needed. */
+  void QueueWear(int32 Shots);
+
+  /** Applies PendingWearShots to every active attachment in one pass. */
+  void ApplyPendingWear();
+
   UPROPERTY(EditAnywhere, Category="Weapon|Batch")
   float BatchSendInterval = 0.15f;
 
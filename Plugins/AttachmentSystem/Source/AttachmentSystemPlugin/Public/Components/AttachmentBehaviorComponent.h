@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AttachmentBehaviorComponent.generated.h"
+
+/**
+ * @brief Runtime functionality an attachment adds to the weapon it is
+ * built into (zoom, recoil reduction, laser, ...).
+ *
+ * - Created on the attachment by UWeaponBuilderComponent::AddBehaviorComponent
+ *   when the part's BehaviorClass is set, destroyed when the weapon is
+ *   cleared.
+ * - Never ticks on its own: with bTickBehavior set, TickBehavior runs from
+ *   UAttachmentTickSubsystem every BehaviorTickInterval seconds.
+ */
+UCLASS(Abstract, Blueprintable)
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentBehaviorComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UAttachmentBehaviorComponent();
+
+  /** Run TickBehavior through UAttachmentTickSubsystem while built. */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Behavior")
+  bool bTickBehavior = false;
+
+  /** Seconds between TickBehavior calls; 0 = every frame. */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Behavior",
+            meta = (ClampMin = "0", EditCondition = "bTickBehavior"))
+  float BehaviorTickInterval = 0.f;
+
+  /** Per-frame work; DeltaTime is the time since the previous call. */
+  virtual void TickBehavior(float DeltaTime);
+
+protected:
+  /** Blueprint hook for TickBehavior. */
+  UFUNCTION(BlueprintImplementableEvent, Category = "Behavior",
+            meta = (DisplayName = "Tick Behavior"))
+  void ReceiveTickBehavior(float DeltaTime);
+};
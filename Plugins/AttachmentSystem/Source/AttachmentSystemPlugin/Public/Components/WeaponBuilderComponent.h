@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Engine/StreamableManager.h"
 #include "Misc/AttachmentSystemTypes.h"
 #include "WeaponBuilderComponent.generated.h"
 
 class AWeapon;
 class AAttachment;
 class ARailAttachment;
+class UAttachmentSocketMapping;
+class UMeshComponent;
+class UStaticMeshComponent;
 
 /**
  * Component responsible for mounting/dismounting weapons using an attachment
@@ -18,6 +22,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeaponBuilt,
                                             const TArray<AAttachment *> &,
                                             SpawnedAttachments);
 
+/** The built parts are about to be released (ClearWeapon). */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWeaponCleared);
+
+/** Build progress in [0,1]: mesh streaming progress, then 1 once built. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeaponBuildProgress, float,
+                                            Progress);
+
 UCLASS(meta = (BlueprintSpawnableComponent))
 class ATTACHMENTSYSTEMPLUGIN_API UWeaponBuilderComponent
     : public UActorComponent {
@@ -38,18 +49,12 @@ protected:
    */
   virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-public:
-  /** Called every frame if ticking is enabled.
-   *  Useful for per-frame updates related to attachments (rarely needed).
-   *
-   * @param DeltaTime   Time since last frame
-   * @param TickType    Tick type (Game, Editor, etc.)
-   * @param ThisTickFunction Tick function context
-   */
+#if WITH_EDITOR
   virtual void
-  TickComponent(float DeltaTime, enum ELevelTick TickType,
-                FActorComponentTickFunction *ThisTickFunction) override;
+  PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+#endif
 
+public:
   /**
    * Builds (assembles) a weapon from the defined BaseAttachments list.
    *
@@ -58,6 +63,10 @@ public:
    *
    * Spawns all defined attachments, attaches them to the Weapon,
    * and applies their behaviors/stats.
+   *
+   * Attachment meshes that are not resident yet are streamed in one batched
+   * async request first; the graph is built once they arrive, so this call
+   * may return before OnWeaponBuilt fires.
    */
   UFUNCTION(BlueprintCallable, CallInEditor, Category = "Weapon|Builder")
   void BuildWeapon();
@@ -80,7 +89,32 @@ public:
                            AActor *IgnoredActor) const;
 
   /**
-   * Disassembles the weapon by detaching and destroying all child attachments.
+   * Batched collision test for every candidate slot of a rail child.
+   *
+   * Slots are tested lowest first against the cached bounds of every part
+   * already spawned for this weapon, except the rail and the child (AABB
+   * list). A slot that overlaps an AABB is rejected without a probe; every
+   * other slot is decided by DoesCollideWithRail, which also sees world
+   * geometry.
+   *
+   * @param CandidateSlots    Bitmask of slots to test (bit i = slot i).
+   * @param SlotTransforms    World transform per slot, indexed by slot.
+   * @param ChildMesh         Mesh of the attachment being tested.
+   * @param Rail              Rail the child is being mounted on.
+   * @param OutPhysicsProbes  Number of physics overlap queries issued.
+   * @param bStopAtFirstFree  Stop after the first collision-free slot.
+   * @return                  Bitmask of collision-free slots.
+   */
+  uint64 FilterCollisionFreeSlots(uint64 CandidateSlots,
+                                  TConstArrayView<FTransform> SlotTransforms,
+                                  USkeletalMeshComponent *ChildMesh,
+                                  ARailAttachment *Rail,
+                                  int32 &OutPhysicsProbes,
+                                  bool bStopAtFirstFree = true);
+
+  /**
+   * Disassembles the weapon by detaching all child attachments and returning
+   * them to the world's attachment pool.
    *
    * - BlueprintCallable: Can be called at runtime (e.g., when player strips
    * weapon).
@@ -96,6 +130,7 @@ public:
 
   /**
    * Searches for an attachment currently mounted on the weapon by its category.
+   * Constant-time: reads the category index kept up to date by the builder.
    *
    * @param Category   The attachment category to look for (e.g., Optic, Stock).
    * @return           Pointer to the found attachment, or nullptr if none
@@ -104,8 +139,20 @@ public:
   UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
   AAttachment *GetAttachmentAtSocket(EAttachmentCategory Category);
 
+  /**
+   * Every attachment currently mounted in a category, in build order.
+   *
+   * @param Category   The attachment category to look for.
+   * @return           Matching attachments (empty if none).
+   */
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  TArray<AAttachment *> GetAttachmentsInCategory(
+      EAttachmentCategory Category) const;
+
   /**
    * Resolves which socket name corresponds to a given attachment category.
+   * Reads the table baked by RefreshSocketTable (no reflection, no strings),
+   * resolving it first if no build has run yet.
    *
    * @param Category   The attachment category to map (e.g., Barrel →
    * "BarrelSocket").
@@ -113,15 +160,100 @@ public:
    */
   FName GetSocketFromCategory(EAttachmentCategory Category) const;
 
+  /** Rebuilds the per-builder socket table from the defaults and
+   *  SocketMapping. Called at BeginPlay and at the start of every build. */
+  void RefreshSocketTable();
+
+  /** Logs the per-lookup cost of the UEnum string path vs the table. */
+  UFUNCTION(BlueprintCallable, CallInEditor, Category = "Weapon|Debug")
+  void RunSocketLookupBenchmark();
+
   UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Weapon|Builder")
   FORCEINLINE TArray<AAttachment *> GetSpawnedAttachments() {
     return SpawnedAttachments;
   }
 
+  /** Actors, tick functions, mesh components and draw sections of the
+   *  current build. */
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  FWeaponBuildFootprint GetBuildFootprint() const;
+
+  /** Rebuilds the weapon once with one actor per part and once compact,
+   *  logs the measured footprint and build time of both, then restores the
+   *  original mode. Server only; tick time per weapon is measured by the
+   *  AttachmentSystem.Benchmark.CompactBuild automation test. */
+  UFUNCTION(BlueprintCallable, CallInEditor, Category = "Weapon|Debug")
+  void RunCompactBuildReport();
+
+  /**
+   * Merges every visible static part under the weapon root (static
+   * fallbacks, compact static parts) into one mesh. Shown instead of the
+   * parts while the baked view is enabled.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Builder")
+  void BakeMergedMesh();
+
+  /** Schedules BakeMergedMesh for the next frame (if bBakeMergedMesh, and
+   *  never on a dedicated server); several changes in one frame cause one
+   *  bake. Clients are asked by replicated attachments (AAttachment). */
+  void RequestRebake();
+
+  /**
+   * Switches between the individual parts and the merged mesh, e.g. on for
+   * third-person and distant weapons, off for the first-person view.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Builder")
+  void SetBakedViewEnabled(bool bEnabled);
+
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  UStaticMeshComponent *GetBakedMeshComponent() const {
+    return BakedMeshComponent;
+  }
+
+  /**
+   * Hides or shows every mounted part in SmallPartCategories, locally
+   * (hidden-in-game on the meshes, nothing replicated). Works on clients
+   * from the replicated attachment actors and compact parts.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Builder")
+  void SetSmallPartsHidden(bool bHidden);
+
+  /** Rail solver counters from the last BuildWeapon call. */
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  FORCEINLINE FRailPlacementStats GetRailPlacementStats() const {
+    return RailPlacementStats;
+  }
+
+  /** Replaces the root configuration used by the next BuildWeapon call
+   *  (runtime loadouts, automation benchmarks). */
+  void SetBaseAttachments(
+      const TArray<TSubclassOf<AAttachment>> &InBaseAttachments) {
+    BaseAttachments = InBaseAttachments;
+  }
+
+  void SetUseBuildPlanCache(const bool bEnabled) {
+    bUseBuildPlanCache = bEnabled;
+  }
+
+  void SetCompactBuild(const bool bEnabled) { bCompactBuild = bEnabled; }
+
   // Called whenever the weapon is (re)built and attachments are spawned
   UPROPERTY(BlueprintAssignable, Category = "Weapon|Events")
   FOnWeaponBuilt OnWeaponBuilt;
 
+  // Called by ClearWeapon while the built parts are still valid, before
+  // they go back to the pool
+  UPROPERTY(BlueprintAssignable, Category = "Weapon|Events")
+  FOnWeaponCleared OnWeaponCleared;
+
+  // Called while attachment meshes stream in, and with 1.0 once built
+  UPROPERTY(BlueprintAssignable, Category = "Weapon|Events")
+  FOnWeaponBuildProgress OnWeaponBuildProgress;
+
+  /** @return true while BuildWeapon is waiting on attachment meshes. */
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  bool IsBuildPending() const;
+
   /**
    * Adds extra runtime functionality depending on the attachment type.
    *
@@ -131,6 +263,11 @@ public:
    *  - Optic   → adds zoom/ADS component
    *  - Foregrip → adds recoil reduction component
    *  - Laser   → adds targeting/beam component
+   *
+   * Creates the part's BehaviorClass (if any) on the attachment. Behaviour
+   * components do not tick on their own: those with bTickBehavior register
+   * with UAttachmentTickSubsystem at their BehaviorTickInterval. Clearing
+   * the weapon drops their registrations and destroys them.
    */
   void AddBehaviorComponent(AAttachment *Attachment);
 
@@ -163,7 +300,167 @@ protected:
   UPROPERTY()
   TMap<AAttachment *, UActorComponent *> SpawnedBehaviors;
 
+  /** Optional per-weapon socket overrides (defaults to category names). */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon|Builder")
+  TObjectPtr<UAttachmentSocketMapping> SocketMapping;
+
+  /** Replays a cached build plan when this BaseAttachments configuration
+   *  has been built before, instead of searching the graph again. Opt-in:
+   *  rail slots are re-checked, but socket transforms are replayed as
+   *  recorded. */
+  UPROPERTY(EditAnywhere, Category = "Weapon|Builder")
+  bool bUseBuildPlanCache = false;
+
+  /**
+   * Compact build: parts that do not need to be actors (no RPCs, no
+   * replicated state, no actor-bearing descendants) are drawn by mesh
+   * components on the weapon instead. Their actors stay on the server as
+   * hidden, non-ticking, non-replicated data holders so stats, durability
+   * and category lookups keep working.
+   */
+  UPROPERTY(EditAnywhere, Category = "Weapon|Builder")
+  bool bCompactBuild = false;
+
+  /** Parts hidden on weapons below the Full detail tier. */
+  UPROPERTY(EditAnywhere, Category = "Weapon|Builder")
+  TArray<EAttachmentCategory> SmallPartCategories = {
+      EAttachmentCategory::Charm, EAttachmentCategory::RailCover,
+      EAttachmentCategory::EjectionPortCover};
+
+  /** Re-bake the merged static mesh after every build and whenever the
+   *  attachment set changes. */
+  UPROPERTY(EditAnywhere, Category = "Weapon|Builder")
+  bool bBakeMergedMesh = false;
+
+  /** Draws and logs every rail overlap query (editor only). */
+  UPROPERTY(EditAnywhere, Category = "Weapon|Debug")
+  bool bDebugRailQueries = false;
+
+  /** Mounted attachments per category, indexed by EAttachmentCategory. */
+  UPROPERTY(Transient)
+  TArray<FAttachmentCategoryBucket> CategoryIndex;
+
+  /** Mesh-only parts of a compact build, in build order. */
+  UPROPERTY(ReplicatedUsing = OnRep_CompactParts)
+  TArray<FCompactAttachmentPart> CompactParts;
+
+  UFUNCTION()
+  void OnRep_CompactParts();
+
+  /** Components drawing CompactParts (same indices; null if unresolved). */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UMeshComponent>> CompactMeshes;
+
+  /** Server: dormant actors behind CompactParts. */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<AAttachment>> CompactedAttachments;
+
+  /** Merged static parts (see BakeMergedMesh). */
+  UPROPERTY(Transient)
+  TObjectPtr<UStaticMeshComponent> BakedMeshComponent;
+
+  /** Parts folded into BakedMeshComponent, hidden in the baked view. */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UStaticMeshComponent>> BakedSources;
+
+  bool bBakedViewEnabled = false;
+
+  bool bSmallPartsHidden = false;
+
+  /** Rail solver counters, reset at the start of every build. */
+  UPROPERTY(VisibleInstanceOnly, Transient, Category = "Weapon|Builder")
+  FRailPlacementStats RailPlacementStats;
+
 private:
+  /** Fills ResolvedSockets from the defaults and SocketMapping. */
+  void ResolveSocketTable() const;
+
+  /** Category → socket, indexed by EAttachmentCategory. Filled lazily. */
+  mutable FName ResolvedSockets[NumAttachmentCategories];
+  mutable bool bSocketTableResolved = false;
+
+  /** In-flight batched mesh load for the current build, if any. */
+  TSharedPtr<FStreamableHandle> PendingMeshLoad;
+
+  /**
+   * Walks the attachment graph through class defaults and collects every
+   * soft mesh reference that is not loaded yet.
+   *
+   * @param AttachmentClass  Current node class.
+   * @param VisitedClasses   Classes already walked (graph may repeat).
+   * @param OutMeshPaths     Meshes to stream before building.
+   */
+  static void GatherAttachmentMeshes(TSubclassOf<AAttachment> AttachmentClass,
+                                     TSet<UClass *> &VisitedClasses,
+                                     TArray<FSoftObjectPath> &OutMeshPaths);
+
+  /** Spawns and attaches the attachment graph (BFS). Meshes must be loaded. */
+  void BuildWeaponGraph();
+
+  /** Registers a placed attachment in SpawnedAttachments, SpawnedMeshes and
+   *  the category index. */
+  void RegisterAttachment(AAttachment *Attachment, USceneComponent *Mesh);
+
+  /**
+   * Spawns and attaches attachments straight from a flattened build plan:
+   * no socket search. Rail steps re-check their recorded slot (occupancy
+   * and one collision test) and fall back to the rail solver.
+   *
+   * @param Plan  Plan recorded by a previous BuildWeaponGraph.
+   */
+  void ReplayBuildPlan(const FWeaponBuildPlan &Plan);
+
+  /**
+   * Mounts a replayed rail child at its recorded slot if that slot is still
+   * free and collision-free in this world, otherwise through PlaceOnRail.
+   *
+   * @return true if the child was placed and attached.
+   */
+  bool ReplayRailSlot(ARailAttachment *Rail, AAttachment *Instance,
+                      const FWeaponBuildStep &Step);
+
+  /**
+   * Server: turns every part that can be mesh-only into a CompactParts
+   * entry and puts its actor to sleep. Runs after the graph is built.
+   */
+  void CompactAttachments();
+
+  /** Wakes the actors put to sleep by CompactAttachments. */
+  void RestoreCompactedAttachments();
+
+  /** (Re)creates CompactMeshes from CompactParts. */
+  void CreateCompactMeshes();
+  void DestroyCompactMeshes();
+
+  /** Shows either the merged mesh or its sources, per bBakedViewEnabled. */
+  void ApplyBakedView();
+
+  /** Drops the merged mesh and shows its sources again. */
+  void DiscardBakedMesh();
+
+  FTimerHandle RebakeHandle;
+
+  /** Forwards streaming progress to OnWeaponBuildProgress. */
+  void HandleMeshLoadUpdate(TSharedRef<FStreamableHandle> Handle);
+
+  /** Cancels an in-flight mesh load so its build never runs. */
+  void CancelPendingBuild();
+
+  /**
+   * Places a rail child on the first free slot that passes collision.
+   *
+   * Free start slots are resolved from the rail's OccupancyMask and the
+   * child's Size with bit operations; only those candidates reach the
+   * physics overlap test, in ascending slot order.
+   *
+   * @param Rail           Rail parent.
+   * @param ChildInstance  Attachment to mount.
+   * @param TargetSocket   Socket on the rail mesh the child attaches to.
+   * @return               true if the child was placed and attached.
+   */
+  bool PlaceOnRail(ARailAttachment *Rail, AAttachment *ChildInstance,
+                   FName TargetSocket);
+
   /**
    * Recursive traversal of the attachment graph.
    * Spawns and attaches children to the given parent.
@@ -175,21 +472,25 @@ private:
                                       TSet<AAttachment *> &Visited);
 
   /**
-   * Recursive search through the attachment graph for a target category.
+   * Checks an attachment out of the world's attachment pool, spawning a new
+   * one on a pool miss.
+   *
+   * @param AttachmentClass  Class to acquire.
+   * @return                 Ready-to-use attachment, or nullptr.
+   */
+  AAttachment *AcquireAttachment(TSubclassOf<AAttachment> AttachmentClass) const;
+
+  /**
+   * Returns an attachment to the world's attachment pool (reset and hidden).
    *
-   * @param Attachment        Current node in the graph.
-   * @param TargetCategory    Category we are searching for.
-   * @param Visited           Tracks visited nodes to avoid loops.
-   * @return                  The first matching attachment, or nullptr if none
-   * found.
+   * @param Attachment  Attachment no longer used by this weapon.
    */
-  AAttachment *FindAttachmentRecursive(AAttachment *Attachment,
-                                       EAttachmentCategory TargetCategory,
-                                       TSet<AAttachment *> &Visited);
+  void ReleaseAttachment(AAttachment *Attachment) const;
 
   /**
    * Recursive cleanup of the attachment graph.
-   * Detaches and destroys all child attachments under the given node.
+   * Detaches all child attachments under the given node and returns them to
+   * the attachment pool.
    *
    * @param Attachment  Current node being cleaned.
    * @param Visited     Tracks visited nodes to avoid double free or loops.
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AmmoOpBuffer.generated.h"
+
+/** Ammo operations a client can request on a magazine or barrel. */
+UENUM()
+enum class EAmmoOpType : uint8 {
+  /** Magazine: load Count rounds of BulletType. */
+  LoadRounds,
+
+  /** Magazine: remove Count rounds from the front. */
+  RemoveRounds,
+
+  /** Barrel: empty the chamber. */
+  ClearChamber,
+
+  /** Barrel: chamber Count rounds of BulletType after the current ones. */
+  ChamberRounds,
+
+  Count UMETA(Hidden)
+};
+
+/**
+ * @brief One recorded ammo operation (op, bullet type, round count).
+ *
+ * Net serialized as 2 + 3 bits plus a packed count, so a run of identical
+ * operations costs about two bytes.
+ */
+USTRUCT()
+struct ATTACHMENTSYSTEMPLUGIN_API FAmmoOp {
+  GENERATED_BODY()
+
+  /** Hard cap on rounds in one op and ops in one RPC (server validation). */
+  static constexpr int32 MaxRoundsPerOp = 1024;
+  static constexpr int32 MaxOpsPerFlush = 64;
+
+  UPROPERTY()
+  EAmmoOpType Op = EAmmoOpType::LoadRounds;
+
+  UPROPERTY()
+  EBulletType BulletType = EBulletType::None;
+
+  UPROPERTY()
+  int32 Count = 1;
+
+  /** Range checks a server runs before applying an op. */
+  bool IsValid() const;
+
+  bool NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FAmmoOp>
+    : public TStructOpsTypeTraitsBase2<FAmmoOp> {
+  enum {
+    WithNetSerializer = true,
+  };
+};
+
+/**
+ * @brief Client-side command buffer for ammo operations.
+ *
+ * Adjacent operations of the same kind are merged (thirty single-round
+ * loads become one LoadRounds x30), and a ClearChamber drops the chamber
+ * operations it supersedes. The owner flushes the buffer as one
+ * Server_ApplyAmmoOps call.
+ */
+struct ATTACHMENTSYSTEMPLUGIN_API FAmmoOpBuffer {
+  /** Records an op, merging it into the previous one when possible. */
+  void Record(EAmmoOpType Op, EBulletType BulletType = EBulletType::None,
+              int32 Count = 1);
+
+  /** Moves the recorded ops into OutOps (at most MaxOpsPerFlush; the rest
+   *  stay queued for the next flush). */
+  void Flush(TArray<FAmmoOp> &OutOps);
+
+  int32 Num() const { return Ops.Num(); }
+  bool IsEmpty() const { return Ops.IsEmpty(); }
+  void Reset() { Ops.Reset(); }
+
+  /** Operations recorded since creation, before merging. */
+  int32 GetNumRecorded() const { return NumRecorded; }
+
+private:
+  TArray<FAmmoOp, TInlineAllocator<8>> Ops;
+  int32 NumRecorded = 0;
+};
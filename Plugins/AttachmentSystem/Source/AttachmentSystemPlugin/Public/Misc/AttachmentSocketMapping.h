@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AttachmentSocketMapping.generated.h"
+
+/**
+ * @brief Per-weapon socket overrides.
+ *
+ * Categories not listed here keep their default socket (the enum identifier).
+ * Assign it on a UWeaponBuilderComponent when a weapon skeleton uses
+ * different socket names.
+ */
+UCLASS(BlueprintType)
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentSocketMapping : public UDataAsset {
+  GENERATED_BODY()
+
+public:
+  /** Category → socket name on the parent mesh. */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sockets")
+  TMap<EAttachmentCategory, FName> SocketOverrides;
+};
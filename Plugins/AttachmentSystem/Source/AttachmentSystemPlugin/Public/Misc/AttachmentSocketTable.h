@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AttachmentSystemTypes.h"
+
+/**
+ * @brief Precomputed EAttachmentCategory → socket FName table.
+ *
+ * Default socket names match the enum identifiers (e.g. Barrel → "Barrel").
+ * The FNames are read from UEnum reflection once at module startup so
+ * lookups during a build are a plain array index: no FString, no name
+ * hashing.
+ */
+namespace AttachmentSockets {
+/** Builds the FName table. Called from StartupModule, safe to call again. */
+ATTACHMENTSYSTEMPLUGIN_API void Initialize();
+
+/** @return Default socket for Category (NAME_None if out of range). */
+ATTACHMENTSYSTEMPLUGIN_API FName GetDefaultSocket(EAttachmentCategory Category);
+
+/** Legacy reflection path (UEnum name → FString → FName), kept for
+ *  benchmarking against the table. */
+ATTACHMENTSYSTEMPLUGIN_API FName
+GetDefaultSocketFromEnum(EAttachmentCategory Category);
+} // namespace AttachmentSockets
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AmmoOpBuffer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * @brief Per-event diagnostics as Unreal Insights trace events.
+ *
+ * Ammo changes, shots, attach decisions and rail probes are written as small
+ * binary events on the `AttachmentSystem` channel instead of formatted log
+ * lines. Enable with `-trace=AttachmentSystem` or `Trace.Enable
+ * AttachmentSystem`; while the channel is off every call site is one branch.
+ * Objects are identified by UObject unique id, never by name.
+ */
+
+#ifndef ATTACHMENT_SYSTEM_TRACE_ENABLED
+#define ATTACHMENT_SYSTEM_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#if ATTACHMENT_SYSTEM_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(AttachmentSystemChannel, ATTACHMENTSYSTEMPLUGIN_API);
+
+namespace AttachmentSystemTrace {
+/** Magazine or barrel contents changed (Remaining = rounds left after). */
+ATTACHMENTSYSTEMPLUGIN_API void OutputAmmo(const UObject *Owner,
+                                           EAmmoOpType Op,
+                                           EBulletType BulletType,
+                                           int32 Count, int32 Remaining);
+
+/** Weapon fired Shots shots (Rounds projectiles, first one FirstRound). */
+ATTACHMENTSYSTEMPLUGIN_API void OutputFire(const UObject *Weapon, int32 Shots,
+                                           int32 Rounds,
+                                           EBulletType FirstRound);
+
+/** Builder attached (or rejected) Child on Parent; Slot is -1 off-rail. */
+ATTACHMENTSYSTEMPLUGIN_API void OutputAttach(const UObject *Builder,
+                                             const UObject *Child,
+                                             const UObject *Parent,
+                                             int32 Slot, bool bAttached);
+
+/** One rail collision probe and its overlap count. */
+ATTACHMENTSYSTEMPLUGIN_API void OutputRailProbe(const UObject *Builder,
+                                                const FVector &Location,
+                                                int32 Overlaps, bool bHit);
+} // namespace AttachmentSystemTrace
+
+#define ATTACHMENT_TRACE(Func, ...)                                            \
+  do {                                                                         \
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AttachmentSystemChannel)) {            \
+      AttachmentSystemTrace::Func(__VA_ARGS__);                                \
+    }                                                                          \
+  } while (0)
+
+#else
+
+#define ATTACHMENT_TRACE(Func, ...)                                            \
+  do {                                                                         \
+  } while (0)
+
+#endif
+
+#define TRACE_ATTACHMENT_AMMO(Owner, Op, BulletType, Count, Remaining)         \
+  ATTACHMENT_TRACE(OutputAmmo, Owner, Op, BulletType, Count, Remaining)
+#define TRACE_ATTACHMENT_FIRE(Weapon, Shots, Rounds, FirstRound)               \
+  ATTACHMENT_TRACE(OutputFire, Weapon, Shots, Rounds, FirstRound)
+#define TRACE_ATTACHMENT_ATTACH(Builder, Child, Parent, Slot, bAttached)       \
+  ATTACHMENT_TRACE(OutputAttach, Builder, Child, Parent, Slot, bAttached)
+#define TRACE_ATTACHMENT_RAIL_PROBE(Builder, Location, Overlaps, bHit)         \
+  ATTACHMENT_TRACE(OutputRailProbe, Builder, Location, Overlaps, bHit)
+
+/**
+ * Cycle stat scope shown in `stat AttachmentSystem`. Stat scopes are also
+ * named CPU scopes in Insights; builds compiled without STATS (Test,
+ * Shipping with trace) still emit the Insights scope under the stat's name.
+ */
+#if STATS
+#define ATTACHMENT_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define ATTACHMENT_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
@@ -4,9 +4,27 @@
 #include "AttachmentSystemTypes.generated.h"
 
 class AAttachment;
+class UAttachmentSocketMapping;
+class UStaticMesh;
+
+// Compile-time ceiling for LogAttachmentSystem. Per-event lines log at
+// Verbose/VeryVerbose and are stripped from shipping; use the trace channel in
+// Misc/AttachmentSystemTrace.h for per-event data instead.
+#ifndef ATTACHMENT_SYSTEM_LOG_COMPILE_VERBOSITY
+#if UE_BUILD_SHIPPING
+#define ATTACHMENT_SYSTEM_LOG_COMPILE_VERBOSITY Warning
+#else
+#define ATTACHMENT_SYSTEM_LOG_COMPILE_VERBOSITY All
+#endif
+#endif
 
 // Clean UE log category for this class
-DECLARE_LOG_CATEGORY_EXTERN(LogAttachmentSystem, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogAttachmentSystem, Log,
+                            ATTACHMENT_SYSTEM_LOG_COMPILE_VERBOSITY);
+
+// `stat AttachmentSystem`
+DECLARE_STATS_GROUP(TEXT("AttachmentSystem"), STATGROUP_AttachmentSystem,
+                    STATCAT_Advanced);
 
 /**
  * @brief Defines how weapon durability should be calculated.
@@ -172,6 +190,10 @@ enum class EAttachmentCategory : uint8 {
   Charm UMETA(DisplayName = "Charm")
 };
 
+/** Number of EAttachmentCategory values (Charm must stay last). */
+constexpr int32 NumAttachmentCategories =
+    static_cast<int32>(EAttachmentCategory::Charm) + 1;
+
 /**
  * @brief Defines the method used to modify a weapon stat.
  * This is intended to be used by attachments and other modifiers.
@@ -346,6 +368,13 @@ struct FAttachmentInfo : public FTableRowBase {
             Category = "Attachment|Display")
   TSoftObjectPtr<USkeletalMesh> Mesh;
 
+  /** Static version of Mesh (same pivot and sockets), drawn instead when
+   *  Mesh has no animated bones. Needs CPU access to be merged in cooked
+   *  builds (see UWeaponBuilderComponent::BakeMergedMesh). */
+  UPROPERTY(EditDefaultsOnly, BlueprintReadWrite,
+            Category = "Attachment|Display")
+  TSoftObjectPtr<UStaticMesh> StaticMesh;
+
   /* =============================
    * Classification
    * ============================= */
@@ -391,6 +420,220 @@ struct FAttachmentInfo : public FTableRowBase {
    */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attachment|Stats")
   float Durability = 100.f;
+
+  /* =============================
+   * Magazine
+   * ============================= */
+
+  /** Round capacity for magazine rows.
+   *  - 0 → derived from the magazine class's EMagazineType.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attachment|Magazine",
+            meta = (ClampMin = "0"))
+  int32 MagazineCapacity = 0;
+};
+
+/**
+ * @brief Counters produced by the rail slot solver during a weapon build.
+ * Compares the physics probes actually issued against a linear per-slot scan.
+ */
+USTRUCT(BlueprintType, Category = "Attachments")
+struct FRailPlacementStats {
+  GENERATED_BODY()
+
+  /** Rail children the solver tried to place. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rail")
+  int32 Placements = 0;
+
+  /** Candidate slots rejected without a physics probe because their box
+   *  overlaps the bounds of another part of the weapon. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rail")
+  int32 BroadphaseRejects = 0;
+
+  /** Candidate slots clear of every part's bounds, probed against the
+   *  physics scene. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rail")
+  int32 PhysicsProbes = 0;
+
+  /** Probes a linear slot scan would have issued but the mask or the bounds
+   *  test made unnecessary. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rail")
+  int32 ProbesSkipped = 0;
+};
+
+/**
+ * @brief Counters reported by the per-world attachment pool.
+ */
+USTRUCT(BlueprintType, Category = "Attachments")
+struct FAttachmentPoolStats {
+  GENERATED_BODY()
+
+  /** Acquires served from a pooled actor. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+  int32 Hits = 0;
+
+  /** Acquires that had to spawn a new actor. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+  int32 Misses = 0;
+
+  /** Actors currently idle in the pool (all classes). */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+  int32 PoolSize = 0;
+
+  /** Highest PoolSize reached. */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+  int32 PeakPoolSize = 0;
+};
+
+/**
+ * @brief Attachments of one category mounted on a weapon.
+ */
+USTRUCT()
+struct FAttachmentCategoryBucket {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<TObjectPtr<AAttachment>> Attachments;
+};
+
+/**
+ * @brief One flattened step of a weapon build: spawn, attach, place.
+ */
+USTRUCT()
+struct FWeaponBuildStep {
+  GENERATED_BODY()
+
+  /** Attachment class to spawn. */
+  UPROPERTY()
+  TSubclassOf<AAttachment> AttachmentClass;
+
+  /** Step that spawned the parent (INDEX_NONE = root on the weapon). */
+  UPROPERTY()
+  int32 ParentStep = INDEX_NONE;
+
+  /** Index into the parent's ChildrenLinks. */
+  UPROPERTY()
+  int32 LinkIndex = INDEX_NONE;
+
+  /** Socket on the parent mesh. */
+  UPROPERTY()
+  FName Socket;
+
+  /** Resolved rail slot (INDEX_NONE = not mounted through the rail). */
+  UPROPERTY()
+  int32 RailSlot = INDEX_NONE;
+
+  /** Final transform relative to the parent socket. */
+  UPROPERTY()
+  FTransform RelativeTransform = FTransform::Identity;
+};
+
+/**
+ * @brief Flat, search-free build recipe for one BaseAttachments configuration.
+ */
+USTRUCT()
+struct FWeaponBuildPlan {
+  GENERATED_BODY()
+
+  /** Configuration the plan was recorded for (guards hash collisions). */
+  UPROPERTY()
+  TArray<TSubclassOf<AAttachment>> RootClasses;
+
+  /** Socket overrides the plan was recorded with (sockets are baked in). */
+  UPROPERTY()
+  TObjectPtr<UAttachmentSocketMapping> SocketMapping;
+
+  /** Steps in build order; parents always precede their children. */
+  UPROPERTY()
+  TArray<FWeaponBuildStep> Steps;
+};
+
+/**
+ * @brief Mesh-only part of a compact build (no actor on clients).
+ *
+ * Replicated by the builder; every machine recreates one mesh component on
+ * the weapon per entry. Parents always precede their children.
+ */
+USTRUCT()
+struct FCompactAttachmentPart {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TObjectPtr<USkeletalMesh> Mesh;
+
+  /** Static fallback drawn instead of Mesh (leaf parts only, since child
+   *  parts attach to skeletal sockets). */
+  UPROPERTY()
+  TObjectPtr<UStaticMesh> StaticMesh;
+
+  /** Category of the part (drives small-part hiding on remote weapons). */
+  UPROPERTY()
+  EAttachmentCategory Category = EAttachmentCategory::MonolithicReceiver;
+
+  /** Compact part this one hangs from (INDEX_NONE = see ParentActor). */
+  UPROPERTY()
+  int32 ParentPart = INDEX_NONE;
+
+  /** Attachment actor this one hangs from (when ParentPart is unset). */
+  UPROPERTY()
+  TObjectPtr<AAttachment> ParentActor;
+
+  /** Hangs from the weapon root (no parent part or actor). */
+  UPROPERTY()
+  bool bOnWeaponRoot = false;
+
+  /** Socket on the parent mesh. */
+  UPROPERTY()
+  FName Socket;
+
+  /** Transform relative to the parent socket. */
+  UPROPERTY()
+  FTransform RelativeTransform = FTransform::Identity;
+};
+
+/**
+ * @brief Render detail of a weapon, picked by UWeaponSignificanceSubsystem.
+ */
+UENUM(BlueprintType)
+enum class EWeaponDetailTier : uint8 {
+  /** Every part drawn individually. */
+  Full UMETA(DisplayName = "Full"),
+
+  /** Small parts (charms, covers, ...) hidden. */
+  Reduced UMETA(DisplayName = "Reduced"),
+
+  /** Merged mesh drawn instead of the static parts, small parts hidden. */
+  Merged UMETA(DisplayName = "Merged"),
+};
+
+/** Number of EWeaponDetailTier values. */
+inline constexpr int32 NumWeaponDetailTiers =
+    static_cast<int32>(EWeaponDetailTier::Merged) + 1;
+
+/** Actor/tick/draw counts of an assembled weapon (see compact builds). */
+USTRUCT(BlueprintType)
+struct FWeaponBuildFootprint {
+  GENERATED_BODY()
+
+  /** Attachment actors with a replication channel. */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Footprint")
+  int32 ReplicatedActors = 0;
+
+  /** Attachment actors and mesh components with an enabled tick. */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Footprint")
+  int32 TickFunctions = 0;
+
+  /** Visible skeletal and static mesh components. */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Footprint")
+  int32 MeshComponents = 0;
+
+  /** Visible mesh components drawn from a static fallback (no skinning). */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Footprint")
+  int32 StaticMeshComponents = 0;
+
+  /** Mesh sections drawn (one draw call each, per pass). */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Footprint")
+  int32 DrawSections = 0;
 };
 
 USTRUCT(BlueprintType, Category = "Attachments")
@@ -421,6 +664,18 @@ struct FWeaponInfo : public FTableRowBase {
   /** Attachments linked by default (ex: spawn with optic, stock, etc.). */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Attachments")
   TArray<TSubclassOf<AAttachment>> LinkedAttachments;
+
+  /** Stats before attachment modifiers (missing stats start at 0). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Stats")
+  TMap<EWeaponStat, float> BaseStats;
+
+  /** Durability every attachment loses per shot at wear coefficient 1. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Wear")
+  float WearPerShot = 0.5f;
+
+  /** Per-category wear multipliers (missing categories use 1). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Wear")
+  TMap<EAttachmentCategory, float> WearCoefficients;
 };
 
 USTRUCT(BlueprintType, Category = "Attachments")
@@ -433,7 +688,8 @@ struct FWeaponCurrentState {
 
   /** Current durability at runtime.
    *  - Starts from base or recalculated from attachments.
-   *  - Decreases with use/damage.
+   *  - Decreases with use/damage: firing wear goes to the attachments
+   *    (UAttachmentWearSubsystem) and this mirrors their aggregate.
    *  - Can be repaired or reset.
    */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Stats")
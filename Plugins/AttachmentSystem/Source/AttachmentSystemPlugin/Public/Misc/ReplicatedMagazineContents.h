@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "Misc/PackedRoundSequence.h"
+#include "ReplicatedMagazineContents.generated.h"
+
+/**
+ * @brief Magazine contents replicated as a delta stream.
+ *
+ * Rounds are addressed by absolute indices: Head counts every round ever
+ * removed, Tail every round ever loaded. A delta carries the new Head/Tail
+ * plus only the rounds loaded since the client's acknowledged Tail (3 bits
+ * each). Removals cost nothing beyond the new Head.
+ *
+ * All changes made between two net updates (a full reload, a burst) are
+ * folded into one delta, since NetDeltaSerialize runs once per update.
+ */
+USTRUCT()
+struct ATTACHMENTSYSTEMPLUGIN_API FReplicatedMagazineContents {
+  GENERATED_BODY()
+
+  /** Server: rounds appended at the back. */
+  void Load(EBulletType Type, int32 NumRounds = 1);
+  void Load(TConstArrayView<EBulletType> Rounds);
+
+  /** Server: NumRounds removed from the front. */
+  void Consume(int32 NumRounds);
+
+  /** Server: everything removed (Head catches up with Tail). */
+  void ConsumeAll() { Consume(Rounds.Num()); }
+
+  /** Live rounds, front first (valid on server and clients). */
+  const FPackedRoundSequence &GetRounds() const { return Rounds; }
+
+  /** Payload bytes written by the last delta / since spawn (server). */
+  int32 GetLastDeltaBytes() const { return LastDeltaBytes; }
+  int64 GetTotalDeltaBytes() const { return TotalDeltaBytes; }
+
+  bool NetDeltaSerialize(FNetDeltaSerializeInfo &DeltaParms);
+
+private:
+  /** Absolute index of the front round. */
+  uint32 Head = 0;
+
+  /** Absolute index one past the back round. */
+  uint32 Tail = 0;
+
+  /** Rounds in [Head, Tail). */
+  FPackedRoundSequence Rounds;
+
+  int32 LastDeltaBytes = 0;
+  int64 TotalDeltaBytes = 0;
+};
+
+template <>
+struct TStructOpsTypeTraits<FReplicatedMagazineContents>
+    : public TStructOpsTypeTraitsBase2<FReplicatedMagazineContents> {
+  enum {
+    WithNetDeltaSerializer = true,
+  };
+};
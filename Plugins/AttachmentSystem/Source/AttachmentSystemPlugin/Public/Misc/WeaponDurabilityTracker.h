@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Running durability aggregate over a weapon's attachments.
+ *
+ * Keeps a running sum and a sorted copy of every tracked value, so average,
+ * minimum and maximum are O(1) reads. Updates are O(log n) search plus a
+ * small memmove (a weapon has a few dozen parts at most).
+ */
+class ATTACHMENTSYSTEMPLUGIN_API FWeaponDurabilityTracker {
+public:
+  /** Starts tracking a value. */
+  void Add(float Durability);
+
+  /** Stops tracking one occurrence of a value (ignored if not tracked). */
+  void Remove(float Durability);
+
+  /** Replaces one tracked value with another. */
+  void Update(float OldDurability, float NewDurability);
+
+  /** Stops tracking everything. */
+  void Reset();
+
+  int32 Num() const { return Sorted.Num(); }
+
+  float GetAverage() const {
+    return Sorted.Num() > 0 ? static_cast<float>(Sum / Sorted.Num()) : 0.f;
+  }
+  float GetMin() const { return Sorted.Num() > 0 ? Sorted[0] : 0.f; }
+  float GetMax() const { return Sorted.Num() > 0 ? Sorted.Last() : 0.f; }
+
+private:
+  /** Double keeps long add/remove sequences from drifting. */
+  double Sum = 0.0;
+
+  /** Tracked values, ascending. */
+  TArray<float> Sorted;
+};
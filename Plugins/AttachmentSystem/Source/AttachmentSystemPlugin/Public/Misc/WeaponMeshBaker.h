@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AttachmentSystemTypes.h"
+
+class UStaticMeshComponent;
+
+/**
+ * @brief Merges the static parts of an assembled weapon into one mesh.
+ *
+ * LOD0 of every source mesh is read from its render data, moved into the
+ * weapon's space and appended to a single mesh description, one polygon
+ * group per material. The result draws with one call per material instead
+ * of one per part and section.
+ */
+namespace WeaponMeshBaker {
+/**
+ * @param Outer          Owner of the transient merged mesh.
+ * @param Sources        Static mesh components to merge.
+ * @param RootTransform  World transform the merged mesh is expressed in.
+ * @param OutMerged      Components that were merged (the others lacked
+ *                       CPU-readable render data).
+ * @return               Merged mesh, or nullptr if nothing could be merged.
+ */
+ATTACHMENTSYSTEMPLUGIN_API UStaticMesh *
+BakeStaticMeshes(UObject *Outer,
+                 TConstArrayView<UStaticMeshComponent *> Sources,
+                 const FTransform &RootTransform,
+                 TArray<UStaticMeshComponent *> &OutMerged);
+} // namespace WeaponMeshBaker
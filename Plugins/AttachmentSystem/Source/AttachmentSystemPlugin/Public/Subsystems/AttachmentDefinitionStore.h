@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AttachmentDefinitionStore.generated.h"
+
+/**
+ * @brief Process-wide store of immutable attachment definitions.
+ *
+ * - One resolved FAttachmentInfo per (DataTable, row ID), shared by every
+ *   attachment instance that uses that row instead of a copy per actor.
+ * - Instances hold a shared reference, so invalidating the store (e.g. a
+ *   DataTable edit in the editor) never leaves them dangling; they pick up
+ *   the new row on their next LoadAttachmentInfo.
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentDefinitionStore
+    : public UEngineSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Resolves a row, reading the DataTable only on the first request.
+   *
+   * @param DataTable  Table holding FAttachmentInfo rows.
+   * @param RowName    Row ID (AAttachment::ID).
+   * @return           Shared definition, or nullptr if the row is missing.
+   */
+  TSharedPtr<const FAttachmentInfo> FindDefinition(const UDataTable *DataTable,
+                                                   FName RowName);
+
+  /** Drops every cached definition. */
+  UFUNCTION(BlueprintCallable, Category = "Attachment")
+  void InvalidateDefinitions();
+
+  /** @return Number of distinct definitions currently shared. */
+  UFUNCTION(BlueprintPure, Category = "Attachment")
+  int32 GetNumDefinitions() const { return Definitions.Num(); }
+
+private:
+  using FDefinitionKey = TPair<FObjectKey, FName>;
+
+  /** Drops the definitions of a single table. */
+  void InvalidateTable(const UDataTable *DataTable);
+
+  TMap<FDefinitionKey, TSharedPtr<const FAttachmentInfo>> Definitions;
+
+#if WITH_EDITOR
+  /** Tables whose change delegate we are bound to. */
+  TSet<FObjectKey> WatchedTables;
+#endif
+};
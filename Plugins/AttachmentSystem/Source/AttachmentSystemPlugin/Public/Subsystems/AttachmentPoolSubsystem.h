@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AttachmentPoolSubsystem.generated.h"
+
+/** Idle attachments of a single class. */
+USTRUCT()
+struct FAttachmentPoolBucket {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<TObjectPtr<AAttachment>> Attachments;
+};
+
+/**
+ * @brief Per-world pool of attachment actors, keyed by attachment class.
+ *
+ * - UWeaponBuilderComponent checks attachments out when building and returns
+ *   them when clearing or when a placement fails, instead of spawning and
+ *   destroying actors on every rebuild/respawn.
+ * - Returned actors are reset (mesh, child instances, runtime state),
+ *   hidden and have collision disabled until checked out again.
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentPoolSubsystem
+    : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Destroys every pooled actor when the world goes away. */
+  virtual void Deinitialize() override;
+
+  /**
+   * Checks out an attachment of the given class, spawning one on a miss.
+   *
+   * @param AttachmentClass  Class to acquire.
+   * @param Owner            Owner assigned to the attachment (usually the
+   * weapon).
+   * @return                 Visible, collision-enabled attachment, or nullptr.
+   */
+  AAttachment *Acquire(TSubclassOf<AAttachment> AttachmentClass,
+                       AActor *Owner);
+
+  /**
+   * Returns an attachment to the pool. The attachment is reset, hidden and
+   * stops colliding until acquired again.
+   *
+   * @param Attachment  Attachment to pool.
+   */
+  void Release(AAttachment *Attachment);
+
+  /** Destroys every idle attachment (counters are kept). */
+  UFUNCTION(BlueprintCallable, Category = "Attachment|Pool")
+  void EmptyPool();
+
+  /** Hit/miss and size counters since the world started. */
+  UFUNCTION(BlueprintPure, Category = "Attachment|Pool")
+  FORCEINLINE FAttachmentPoolStats GetPoolStats() const { return PoolStats; }
+
+private:
+  /** Idle attachments, per class. */
+  UPROPERTY()
+  TMap<TSubclassOf<AAttachment>, FAttachmentPoolBucket> Pool;
+
+  UPROPERTY()
+  FAttachmentPoolStats PoolStats;
+};
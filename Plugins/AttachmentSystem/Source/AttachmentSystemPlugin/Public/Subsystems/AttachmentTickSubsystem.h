@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AttachmentTickSubsystem.generated.h"
+
+/** Called with the time elapsed since the callback last ran. */
+DECLARE_DELEGATE_OneParam(FAttachmentTickDelegate, float);
+
+/** Identifies one registration with UAttachmentTickSubsystem. */
+struct FAttachmentTickHandle {
+  uint32 Id = 0;
+
+  bool IsValid() const { return Id != 0; }
+  void Invalidate() { Id = 0; }
+};
+
+/**
+ * @brief One world tick for every attachment-side behaviour that needs it.
+ *
+ * - Attachments, weapons and the builder do not tick. Behaviour components
+ *   (see UWeaponBuilderComponent::AddBehaviorComponent) register a callback
+ *   here with the rate they need instead of enabling their own tick.
+ * - Registrations live in one dense array walked once per frame; each
+ *   entry accumulates time and fires once its interval has elapsed.
+ * - Entries whose owner is gone are dropped during the walk, so owners
+ *   that forget to unregister cost one weak pointer check.
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentTickSubsystem
+    : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * @param Owner     Object the callback belongs to (entry dies with it).
+   * @param Callback  Called with the elapsed time since its last call.
+   * @param Interval  Seconds between calls; 0 = every frame.
+   * @return          Handle for UnregisterTick / SetTickInterval.
+   */
+  FAttachmentTickHandle RegisterTick(const UObject *Owner,
+                                     FAttachmentTickDelegate Callback,
+                                     float Interval = 0.f);
+
+  /** Stops a callback and invalidates the handle. */
+  void UnregisterTick(FAttachmentTickHandle &Handle);
+
+  /** Stops every callback registered by Owner. */
+  void UnregisterAllTicks(const UObject *Owner);
+
+  /** Changes the rate of a registered callback. */
+  void SetTickInterval(const FAttachmentTickHandle &Handle, float Interval);
+
+  /** Live registrations (for profiling). */
+  UFUNCTION(BlueprintPure, Category = "Attachment|Tick")
+  int32 GetNumRegisteredTicks() const { return IndexById.Num(); }
+
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+
+private:
+  struct FTickEntry {
+    TWeakObjectPtr<const UObject> Owner;
+    FAttachmentTickDelegate Callback;
+    float Interval = 0.f;
+    float Accumulated = 0.f;
+    uint32 Id = 0;
+  };
+
+  /** Dense, unordered; removal swaps the last entry in. */
+  TArray<FTickEntry> Entries;
+
+  /** Registration id → index in Entries. */
+  TMap<uint32, int32> IndexById;
+
+  uint32 NextId = 1;
+
+  /** True while Tick walks Entries (removals are deferred). */
+  bool bTicking = false;
+
+  /** Swap-removes Entries[Index], keeping IndexById in sync. */
+  void RemoveAt(int32 Index);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "AttachmentWearSubsystem.generated.h"
+
+/**
+ * @brief Applies firing wear to attachments, one pass per firing batch.
+ *
+ * - AWeapon collects shots during its BatchSendInterval window and hands the
+ *   count to ApplyBatchWear when the batch is processed.
+ * - Every active attachment loses Shots * WearPerShot * coefficient of its
+ *   category, computed 4 attachments at a time over packed float arrays.
+ * - Results go back through AAttachment::SetDurability, so the weapon's
+ *   durability aggregate stays in sync.
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UAttachmentWearSubsystem
+    : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * @param Attachments          Parts to wear (nullptrs are skipped).
+   * @param Shots                Shots fired during the batch.
+   * @param WearPerShot          Durability lost per shot at coefficient 1.
+   * @param CategoryCoefficients Wear multiplier per EAttachmentCategory
+   *                             (NumAttachmentCategories entries).
+   */
+  void ApplyBatchWear(TConstArrayView<AAttachment *> Attachments, int32 Shots,
+                      float WearPerShot,
+                      TConstArrayView<float> CategoryCoefficients);
+
+  /** Attachments worn since the world started (for profiling). */
+  UFUNCTION(BlueprintPure, Category = "Attachment|Wear")
+  FORCEINLINE int64 GetWornAttachmentCount() const { return WornAttachments; }
+
+  /** Batches processed since the world started (for profiling). */
+  UFUNCTION(BlueprintPure, Category = "Attachment|Wear")
+  FORCEINLINE int64 GetBatchCount() const { return Batches; }
+
+private:
+  /** Scratch buffers reused by every batch (4-lane padded, 16-byte aligned). */
+  TArray<AAttachment *> Parts;
+  TArray<float, TAlignedHeapAllocator<16>> Durabilities;
+  TArray<float, TAlignedHeapAllocator<16>> Coefficients;
+
+  int64 WornAttachments = 0;
+  int64 Batches = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "WeaponBuildPlanCache.generated.h"
+
+/**
+ * @brief Process-wide cache of flattened weapon build plans.
+ *
+ * - A plan is recorded the first time a BaseAttachments configuration is
+ *   built (BFS, socket lookups, rail solver) and keyed by a hash of it.
+ * - Later builds of the same configuration replay the plan linearly.
+ * - Plans capture resolved rail slots and socket transforms. Replayed rail
+ *   slots are re-checked by the builder; in the editor the cache is also
+ *   dropped when PIE ends, when Blueprints are reinstanced and when a
+ *   UAttachmentSocketMapping is edited. Invalidate after changing
+ *   attachment classes or DataTables at runtime.
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UWeaponBuildPlanCache
+    : public UEngineSubsystem {
+  GENERATED_BODY()
+
+public:
+  virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+  virtual void Deinitialize() override;
+
+  /**
+   * @param RootClasses    BaseAttachments configuration.
+   * @param SocketMapping  Socket overrides the plan was built with.
+   * @return               Cached plan for it, or nullptr.
+   */
+  const FWeaponBuildPlan *
+  FindPlan(TConstArrayView<TSubclassOf<AAttachment>> RootClasses,
+           const UAttachmentSocketMapping *SocketMapping) const;
+
+  /** Stores (or replaces) the plan for its RootClasses + SocketMapping. */
+  void StorePlan(FWeaponBuildPlan &&Plan);
+
+  /** Drops every cached plan. */
+  UFUNCTION(BlueprintCallable, Category = "Weapon|Builder")
+  void InvalidatePlans();
+
+  /** @return Number of cached configurations. */
+  UFUNCTION(BlueprintPure, Category = "Weapon|Builder")
+  int32 GetNumPlans() const { return Plans.Num(); }
+
+  /** Order-sensitive hash of a BaseAttachments configuration. */
+  static uint32
+  HashConfiguration(TConstArrayView<TSubclassOf<AAttachment>> RootClasses,
+                    const UAttachmentSocketMapping *SocketMapping);
+
+private:
+  /** Drops the plans recorded with one socket mapping. */
+  void InvalidateMapping(const UAttachmentSocketMapping *SocketMapping);
+
+#if WITH_EDITOR
+  void HandleEndPIE(bool bIsSimulating);
+  void HandleObjectsReplaced(const TMap<UObject *, UObject *> &ReplacedObjects);
+  void HandleObjectPropertyChanged(UObject *Object,
+                                   FPropertyChangedEvent &PropertyChangedEvent);
+
+  FDelegateHandle EndPIEHandle;
+  FDelegateHandle ObjectsReplacedHandle;
+  FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+  UPROPERTY()
+  TMap<uint32, FWeaponBuildPlan> Plans;
+};
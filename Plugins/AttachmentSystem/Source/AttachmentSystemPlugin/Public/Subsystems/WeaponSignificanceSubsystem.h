@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Misc/AttachmentSystemTypes.h"
+#include "WeaponSignificanceSubsystem.generated.h"
+
+class AWeapon;
+
+/**
+ * @brief Picks a render detail tier for every weapon seen by local players.
+ *
+ * - A few times per second, weapons are ranked by significance: owned by a
+ *   local player first, then recently rendered, then distance to the
+ *   nearest local view point.
+ * - Rank order fills the tiers by distance band and budget: Full up to
+ *   the Full budget, then Reduced up to its budget, everything else Merged.
+ *   Locally owned weapons are always Full and count against the budget.
+ * - Bands, budgets and the update rate are console variables
+ *   (AttachmentSystem.Significance.*); "AttachmentSystem.DumpWeaponTiers"
+ *   logs the current tier counts.
+ * - Runs per machine, never on dedicated servers (no local view points).
+ */
+UCLASS()
+class ATTACHMENTSYSTEMPLUGIN_API UWeaponSignificanceSubsystem
+    : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Called by AWeapon on BeginPlay / EndPlay. */
+  void RegisterWeapon(AWeapon *Weapon);
+  void UnregisterWeapon(AWeapon *Weapon);
+
+  /** Re-ranks every weapon and applies the resulting tiers now. */
+  void UpdateSignificance();
+
+  /** Weapons per tier after the last update, indexed by EWeaponDetailTier. */
+  int32 GetTierCount(EWeaponDetailTier Tier) const {
+    return TierCounts[static_cast<int32>(Tier)];
+  }
+
+  /** Logs tier counts and budgets. */
+  void DumpTiers() const;
+
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+
+private:
+  /** Registered weapons (unordered). */
+  TArray<TWeakObjectPtr<AWeapon>> Weapons;
+
+  int32 TierCounts[NumWeaponDetailTiers] = {};
+
+  float TimeSinceUpdate = 0.f;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#ifndef DYNAMIC_RING_BUFFER_H
+#define DYNAMIC_RING_BUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Single producer, single-consumer ring buffer with a capacity chosen at
+// runtime (e.g. magazine size picked when the actor spawns).
+// Storage is a heap block rounded up to a power of two so slots are found
+// with a mask; the logical capacity can be any value up to that size, so a
+// 30 round magazine holds exactly 30. Indices are free running unsigned
+// counters, their difference is the fill level.
+// Same Put/Get/block API and memory ordering as Lomont::RingBuffer.
+// MORE THREADS THAN THAT WILL NOT WORK!
+
+// include RELACY thread ordering header before the ringbuffer include to enable
+// relacy testing
+#ifndef RL_RELACY_HPP
+#include <atomic>
+#define NM std
+#define ACCESS(a) a
+#else
+#define NM rl
+#define ACCESS(a) a($)
+#endif
+
+namespace Lomont {
+
+template <typename DataType = char, typename IndexType = uint32_t>
+class DynamicRingBuffer {
+  static_assert(std::is_unsigned<IndexType>::value,
+                "DynamicRingBuffer IndexType must be unsigned (wraps)");
+
+public:
+  explicit DynamicRingBuffer(std::size_t capacity = 1) { Resize(capacity); }
+
+  DynamicRingBuffer(const DynamicRingBuffer &) = delete;
+  DynamicRingBuffer &operator=(const DynamicRingBuffer &) = delete;
+
+  // drop contents and reallocate; NOT thread safe, call while idle
+  void Resize(std::size_t capacity) {
+    capacity_ = capacity > 0 ? capacity : 1;
+    std::size_t storage = 1;
+    while (storage < capacity_)
+      storage <<= 1;
+    mask_ = static_cast<IndexType>(storage - 1);
+    buffer_.reset(new DataType[storage]);
+    writeIndex_.store(0, NM::memory_order_relaxed);
+    readIndex_.store(0, NM::memory_order_relaxed);
+    pReadIndex_ = 0;
+    pWriteIndex_ = 0;
+  }
+
+  // how many items available to read in [0,Size]
+  // same caller caveats as Lomont::RingBuffer
+  std::size_t AvailableToRead() const {
+    return static_cast<IndexType>(writeIndex_.load(NM::memory_order_acquire) -
+                                  readIndex_.load(NM::memory_order_acquire));
+  }
+
+  // how many items available to write in [0,Size]
+  std::size_t AvailableToWrite() const { return Size() - AvailableToRead(); }
+
+  bool IsEmpty() const { return AvailableToRead() == 0; }
+
+  bool IsFull() const { return AvailableToRead() == Size(); }
+
+  // logical capacity, can hold exactly this many
+  std::size_t Size() const { return capacity_; }
+
+  // try to write an element, fails if no space available
+  bool Put(const DataType &datum) {
+    const IndexType w = writeIndex_.load(NM::memory_order_relaxed);
+    if (static_cast<IndexType>(w - pReadIndex_) >= capacity_) {
+      pReadIndex_ = readIndex_.load(NM::memory_order_acquire);
+      if (static_cast<IndexType>(w - pReadIndex_) >= capacity_)
+        return false; // buffer full
+    }
+    buffer_[w & mask_] = datum;
+    writeIndex_.store(static_cast<IndexType>(w + 1), NM::memory_order_release);
+    return true;
+  }
+
+  // try to get an element, fails if none available
+  bool Get(DataType &data) {
+    const IndexType r = readIndex_.load(NM::memory_order_relaxed);
+    if (r == pWriteIndex_) {
+      pWriteIndex_ = writeIndex_.load(NM::memory_order_acquire);
+      if (r == pWriteIndex_)
+        return false; // buffer empty
+    }
+    data = buffer_[r & mask_];
+    readIndex_.store(static_cast<IndexType>(r + 1), NM::memory_order_release);
+    return true;
+  }
+
+  // try to write n elements, fails if no space available
+  bool Put(const DataType *data, std::size_t n) {
+    const IndexType w = writeIndex_.load(NM::memory_order_relaxed);
+    if (capacity_ - static_cast<IndexType>(w - pReadIndex_) < n) {
+      pReadIndex_ = readIndex_.load(NM::memory_order_acquire);
+      if (capacity_ - static_cast<IndexType>(w - pReadIndex_) < n)
+        return false; // does not fit
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      buffer_[static_cast<IndexType>(w + i) & mask_] = data[i];
+    writeIndex_.store(static_cast<IndexType>(w + n), NM::memory_order_release);
+    return true;
+  }
+
+  // try to get n elements, fails if not available
+  bool Get(DataType *data, std::size_t n) {
+    const IndexType r = readIndex_.load(NM::memory_order_relaxed);
+    if (static_cast<IndexType>(pWriteIndex_ - r) < n) {
+      pWriteIndex_ = writeIndex_.load(NM::memory_order_acquire);
+      if (static_cast<IndexType>(pWriteIndex_ - r) < n)
+        return false; // not available
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = buffer_[static_cast<IndexType>(r + i) & mask_];
+    readIndex_.store(static_cast<IndexType>(r + n), NM::memory_order_release);
+    return true;
+  }
+
+private:
+  std::unique_ptr<DataType[]> buffer_;
+  std::size_t capacity_ = 0;
+  IndexType mask_ = 0;
+
+  // producer side: write index and its cached view of the read index
+  NM::atomic<IndexType> writeIndex_{0};
+  IndexType pReadIndex_{0};
+
+  // consumer side: read index and its cached view of the write index
+  NM::atomic<IndexType> readIndex_{0};
+  IndexType pWriteIndex_{0};
+};
+
+} // namespace Lomont
+
+#undef NM
+#undef ACCESS
+
+#endif // DYNAMIC_RING_BUFFER_H
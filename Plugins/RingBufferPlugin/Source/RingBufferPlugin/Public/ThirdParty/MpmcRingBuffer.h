@@ -0,0 +1,173 @@
+#pragma once
+#ifndef MPMC_RING_BUFFER_H
+#define MPMC_RING_BUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "RingBuffer.h" // for mod
+
+// Bounded multi-producer, multi-consumer ring buffer, lock free.
+// Any number of threads may Put and Get concurrently, e.g. many gameplay
+// threads feeding one consumer (fan-in) or one producer handing work to a
+// pool of workers (fan-out).
+// Design is Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence
+// number that says whose turn it is, so a producer and a consumer only ever
+// contend on their own position counter, and on a cell only when the ring is
+// full or empty. Holds exactly N items.
+// N must be a power of 2: positions are free running IndexType counters that
+// wrap, and the cell for a position must not jump when they do.
+
+// include RELACY thread ordering header before the ringbuffer include to enable
+// relacy testing
+#ifndef RL_RELACY_HPP
+#include <atomic>
+#define NM std
+#define ACCESS(a) a
+#define VAR_T(T) T
+#else
+#define NM rl
+#define ACCESS(a) a($)
+#define VAR_T(T) rl::var<T>
+#endif
+
+namespace Lomont {
+
+template <std::size_t N, typename DataType = char, typename IndexType = uint32_t,
+          typename RingMod = FastRingMod<N, IndexType>>
+class MpmcRingBuffer {
+  static_assert(is_power_of_two<N>::value,
+                "MpmcRingBuffer size N must be a power of 2");
+  static_assert(std::is_unsigned<IndexType>::value,
+                "MpmcRingBuffer IndexType must be unsigned (wraps)");
+  static_assert(N <= (std::size_t(1) << (sizeof(IndexType) * 8 - 2)),
+                "MpmcRingBuffer IndexType too small for N");
+
+  using Difference = std::make_signed_t<IndexType>;
+
+public:
+  MpmcRingBuffer() {
+    for (std::size_t i = 0; i < N; ++i)
+      ACCESS(cells_[i].sequence).store(static_cast<IndexType>(i),
+                                       NM::memory_order_relaxed);
+  }
+
+  MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+  MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+  // how many items available to read in [0,N]
+  // a snapshot only: any other thread may be adding or removing
+  std::size_t AvailableToRead() const {
+    const auto r = ACCESS(readIndex_).load(NM::memory_order_acquire);
+    const auto w = ACCESS(writeIndex_).load(NM::memory_order_acquire);
+    // positions are claimed before the cell is filled/emptied, and the two
+    // loads are not one snapshot, so clamp to [0,N]
+    const auto used = static_cast<Difference>(static_cast<IndexType>(w - r));
+    if (used < 0)
+      return 0;
+    return static_cast<std::size_t>(used) < N ? static_cast<std::size_t>(used)
+                                                : N;
+  }
+
+  // how many items available to write in [0,N], same caveats as above
+  std::size_t AvailableToWrite() const { return Size() - AvailableToRead(); }
+
+  bool IsEmpty() const { return AvailableToRead() == 0; }
+
+  bool IsFull() const { return AvailableToRead() == Size(); }
+
+  // size of buffer, can hold exactly this many
+  std::size_t Size() const { return N; }
+
+  // try to write an element, fails if no space available
+  bool Put(const DataType &datum) {
+    auto w = ACCESS(writeIndex_).load(NM::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[Index(w)];
+      const auto seq = ACCESS(cell.sequence).load(NM::memory_order_acquire);
+      const auto diff = static_cast<Difference>(static_cast<IndexType>(seq - w));
+      if (diff == 0) {
+        // cell free for this lap, claim position w
+        if (ACCESS(writeIndex_)
+                .compare_exchange_weak(w, static_cast<IndexType>(w + 1),
+                                       NM::memory_order_relaxed,
+                                       NM::memory_order_relaxed)) {
+          ACCESS(cell.data) = datum;
+          ACCESS(cell.sequence)
+              .store(static_cast<IndexType>(w + 1), NM::memory_order_release);
+          return true;
+        }
+        // lost the race, w now holds the current position
+      } else if (diff < 0) {
+        // consumer of the previous lap has not emptied the cell yet
+        return false; // buffer full
+      } else {
+        // another producer took w, catch up
+        w = ACCESS(writeIndex_).load(NM::memory_order_relaxed);
+      }
+    }
+  }
+
+  // try to get an element, fails if none available
+  bool Get(DataType &data) {
+    auto r = ACCESS(readIndex_).load(NM::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[Index(r)];
+      const auto seq = ACCESS(cell.sequence).load(NM::memory_order_acquire);
+      const auto diff = static_cast<Difference>(
+          static_cast<IndexType>(seq - static_cast<IndexType>(r + 1)));
+      if (diff == 0) {
+        // cell filled for this lap, claim position r
+        if (ACCESS(readIndex_)
+                .compare_exchange_weak(r, static_cast<IndexType>(r + 1),
+                                       NM::memory_order_relaxed,
+                                       NM::memory_order_relaxed)) {
+          data = ACCESS(cell.data);
+          // hand the cell to the producer one lap ahead
+          ACCESS(cell.sequence)
+              .store(static_cast<IndexType>(r + N), NM::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // producer has not filled the cell yet
+        return false; // buffer empty
+      } else {
+        // another consumer took r, catch up
+        r = ACCESS(readIndex_).load(NM::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  // cell for a free running position; the mask to [0,2N-1] is exact since N
+  // is a power of 2, then RingMod maps to [0,N-1] like the SPSC rings
+  static IndexType Index(IndexType position) {
+    return RingMod::Mod1N(static_cast<IndexType>(position & (2 * N - 1)));
+  }
+
+  // sequence == position: free for the producer at position
+  // sequence == position + 1: filled, ready for the consumer at position
+  // sequence == position + N: emptied, free for the producer one lap later
+  struct Cell {
+    NM::atomic<IndexType> sequence;
+    VAR_T(DataType) data;
+  };
+
+  // producers and consumers each hammer their own counter; keep them and the
+  // cells on separate cache lines so they do not false share
+  static constexpr std::size_t CacheLine = 64;
+
+  alignas(CacheLine) NM::atomic<IndexType> writeIndex_{0};
+  alignas(CacheLine) NM::atomic<IndexType> readIndex_{0};
+  alignas(CacheLine) Cell cells_[N];
+};
+
+} // namespace Lomont
+
+#undef NM
+#undef ACCESS
+#undef VAR_T
+
+#endif // MPMC_RING_BUFFER_H
@@ -1,8 +1,24 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "RingBuffer.h"
 #include "Stopwatch.h"
@@ -13,23 +29,87 @@
 #define RING_NAME() "SAMD_RING"
 #define FATAL() Error("Error: Logic error")
 #else
-#define RING_NAME() typeid(RingType).name()
+#define RING_NAME() RingTypeName<RingType>()
 #define FATAL() throw std::logic_error("")
 
 #endif
 
+// run settings for the throughput tests, filled in by main
+struct BenchConfig {
+  int passCount = 100;
+  // "text" is the original log line, "csv" and "json" add ns/op and
+  // pinning for scripts
+  const char *format = "text";
+  // cpu to pin the producer/consumer thread of the double tests to, -1 to
+  // leave placement to the OS
+  int producerCpu = -1;
+  int consumerCpu = -1;
+  int jsonRecords = 0; // records written so far, for the ',' separator
+};
+
+inline BenchConfig &Config() {
+  static BenchConfig config;
+  return config;
+}
+
+#ifndef SAMD21_BUILD
+// readable type name, e.g. "Lomont::RingBuffer<128ul, char, int, ...>"
+template <typename RingType> const char *RingTypeName() {
+  static const std::string name = [] {
+    std::string result = typeid(RingType).name();
+#if defined(__GNUG__)
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(result.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr)
+      result = demangled;
+    std::free(demangled);
+#endif
+    return result;
+  }();
+  return name.c_str();
+}
+
+// pin the calling thread to one cpu, ignored if cpu < 0 or unsupported
+inline void PinThisThread(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0)
+    return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+#endif
+
+// stops the optimizer from folding a put/get round trip through a
+// non-atomic ring into a copy; called once per block of M items
+inline void ClobberMemory() {
+#if defined(__GNUC__)
+  asm volatile("" : : : "memory");
+#else
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
 // stats holds per test statistics
 struct Stats {
   Stats(const char *testName, const char *typeName, size_t bufferSize,
         size_t blockSize, long bytesPerPass) {
 #ifndef SAMD21_BUILD
-    passCount = 100;
+    passCount = Config().passCount;
 #else
     passCount = 10;
 #endif
     totalMs = 0;
     minMs = 1L << 30;
     maxMs = -minMs;
+    totalNs = 0;
+    minNs = UINT64_MAX;
+    maxNs = 0;
     this->testName = testName;
     this->bytesPerPass = bytesPerPass;
     this->typeString = typeName;
@@ -43,10 +123,26 @@ struct Stats {
     maxMs = elapsedMs < maxMs ? maxMs : elapsedMs;
     totalMs += elapsedMs;
   }
+  // ms resolution rounds short passes to 0, so keep ns alongside
+  void AddNs(uint64_t elapsedNs) {
+    minNs = minNs < elapsedNs ? minNs : elapsedNs;
+    maxNs = elapsedNs < maxNs ? maxNs : elapsedNs;
+    totalNs += elapsedNs;
+  }
+  void AddPass(const StopWatch &sw) {
+    Add(sw.ElapsedMs());
+#ifndef SAMD21_BUILD
+    AddNs(sw.ElapsedNs());
+#endif
+  }
   int passCount;
   int64_t totalMs;
   int64_t minMs;
   int64_t maxMs;
+  uint64_t totalNs;
+  uint64_t minNs;
+  uint64_t maxNs;
+  int64_t size = 0; // bytes moved so far (stress test)
   int64_t bytesPerPass; // # bytes processed each pass
   const char *testName;
   const char *typeString;
@@ -55,8 +151,21 @@ struct Stats {
 };
 
 inline void ShowLogFormat() {
-  printf("Test, ring size, block transfer size, avg MB/s, max MB/s, min MB/s, "
-         "success/fail, buffer name, avgMs, \n");
+  if (std::strcmp(Config().format, "csv") == 0)
+    printf("test,ring_size,block_size,pinning,passes,bytes_per_pass,"
+           "ns_per_op,min_ns_per_op,max_ns_per_op,avg_mb_s,max_mb_s,"
+           "min_mb_s,success,buffer\n");
+  else if (std::strcmp(Config().format, "json") == 0)
+    printf("[\n");
+  else
+    printf("Test, ring size, block transfer size, avg MB/s, max MB/s, "
+           "min MB/s, success/fail, buffer name, avgMs, \n");
+}
+
+// closes the json array opened by ShowLogFormat
+inline void EndLogFormat() {
+  if (std::strcmp(Config().format, "json") == 0)
+    printf("\n]\n");
 }
 
 long ZeroToOne(long v) {
@@ -75,6 +184,59 @@ inline void Log(const Stats &stats) {
       (10000 * stats.bytesPerPass / ZeroToOne(stats.minMs)) / (1UL << 20);
 
 #ifndef SAMD21_BUILD
+  const bool csv = std::strcmp(Config().format, "csv") == 0;
+  const bool json = std::strcmp(Config().format, "json") == 0;
+  if (csv || json) {
+    // one op is one item through the ring (a put and a get)
+    const double passes = stats.passCount > 0 ? stats.passCount : 1;
+    const double items = stats.bytesPerPass > 0 ? stats.bytesPerPass : 1;
+    const double avgNs = stats.totalNs / passes;
+    const double mb = stats.bytesPerPass / double(1UL << 20);
+    auto mbPerSec = [mb](double ns) { return ns > 0 ? mb * 1e9 / ns : 0.0; };
+
+    char pinning[32];
+    if (Config().producerCpu < 0 && Config().consumerCpu < 0)
+      snprintf(pinning, sizeof(pinning), "none");
+    else
+      snprintf(pinning, sizeof(pinning), "cpu%d-cpu%d", Config().producerCpu,
+               Config().consumerCpu);
+
+    std::string type = stats.typeString;
+    for (auto &c : type)
+      if (c == '"' || (csv && c == ','))
+        c = csv ? ';' : '\'';
+
+    char buffer[2000];
+    if (csv) {
+      snprintf(buffer, sizeof(buffer),
+               "%s,%ld,%ld,%s,%d,%lld,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%d,%s",
+               stats.testName, (long)stats.bufferSize, (long)stats.blockSize,
+               pinning, stats.passCount, (long long)stats.bytesPerPass,
+               avgNs / items, stats.minNs / items, stats.maxNs / items,
+               mbPerSec(avgNs), mbPerSec((double)stats.minNs),
+               mbPerSec((double)stats.maxNs), stats.success, type.c_str());
+      WriteLine(buffer);
+    } else {
+      snprintf(buffer, sizeof(buffer),
+               "%s  {\"test\": \"%s\", \"ringSize\": %ld, "
+               "\"blockSize\": %ld, \"pinning\": \"%s\", "
+               "\"passes\": %d, \"bytesPerPass\": %lld, "
+               "\"nsPerOp\": %.3f, \"minNsPerOp\": %.3f, "
+               "\"maxNsPerOp\": %.3f, \"avgMBs\": %.1f, "
+               "\"maxMBs\": %.1f, \"minMBs\": %.1f, "
+               "\"success\": %s, \"buffer\": \"%s\"}",
+               Config().jsonRecords++ > 0 ? ",\n" : "", stats.testName,
+               (long)stats.bufferSize, (long)stats.blockSize, pinning,
+               stats.passCount, (long long)stats.bytesPerPass,
+               avgNs / items, stats.minNs / items, stats.maxNs / items,
+               mbPerSec(avgNs), mbPerSec((double)stats.minNs),
+               mbPerSec((double)stats.maxNs),
+               stats.success ? "true" : "false", type.c_str());
+      Write(buffer);
+    }
+    return;
+  }
+
   char name[1000];
   sprintf(name, "%s", stats.typeString);
   // excel having a mess importing names with ',' even when escaped, so...
@@ -121,13 +283,14 @@ uint32_t ThroughputSingleBlock(long size) {
     while (processed < size) {
       rb.Put(buffer + writer, M);
       writer = (writer + M) & 1023;
+      ClobberMemory();
       rb.Get(buffer + reader, M);
       reader = (reader + M) & 1023;
       processed += M;
     }
 
     sw.Stop();
-    stats.Add(sw.ElapsedMs());
+    stats.AddPass(sw);
 
     // check matches
     rnd.seed = 0x12345;
@@ -166,6 +329,7 @@ bool ThroughputDoubleBlock(long size) {
     sw.Start();
 
     std::thread t1([&]() {
+      PinThisThread(Config().producerCpu);
       uint32_t writer = 0;
       long processed = 0;
 
@@ -180,6 +344,7 @@ bool ThroughputDoubleBlock(long size) {
     });
 
     std::thread t2([&]() {
+      PinThisThread(Config().consumerCpu);
       uint32_t reader = 0;
       long processed = 0;
 
@@ -200,7 +365,7 @@ bool ThroughputDoubleBlock(long size) {
       Error("Error: get/put errors");
 
     sw.Stop();
-    stats.Add(sw.ElapsedMs());
+    stats.AddPass(sw);
 
     // check matches
     rnd.seed = 0x12345;
@@ -246,6 +411,7 @@ bool ThroughputSingle(long size) {
         rb.Put(buffer[writer]);
         writer = (writer + 1) & 1023;
       }
+      ClobberMemory();
       for (auto i = 0U; i < M; ++i) {
         rb.Get(buffer[reader]);
         reader = (reader + 1) & 1023;
@@ -257,7 +423,7 @@ bool ThroughputSingle(long size) {
     }
 
     sw.Stop();
-    stats.Add(sw.ElapsedMs());
+    stats.AddPass(sw);
 
     // check matches
     rnd.seed = 0x12345;
@@ -295,6 +461,7 @@ bool ThroughputDouble(long size) {
     sw.Start();
 
     std::thread t1([&]() {
+      PinThisThread(Config().producerCpu);
       uint32_t writer = 0;
       long processed = 0;
 
@@ -311,6 +478,7 @@ bool ThroughputDouble(long size) {
     });
 
     std::thread t2([&]() {
+      PinThisThread(Config().consumerCpu);
       uint32_t reader = 0;
       long processed = 0;
 
@@ -330,7 +498,7 @@ bool ThroughputDouble(long size) {
     t2.join();
 
     sw.Stop();
-    stats.Add(sw.ElapsedMs());
+    stats.AddPass(sw);
 
     stats.success = errors1 + errors2 == 0;
     if (!stats.success)
@@ -351,6 +519,82 @@ bool ThroughputDouble(long size) {
 #endif
 }
 
+// buffer size, producer and consumer thread counts
+// any number of threads on each side, for the MPMC capable rings
+// (LockedRingBuffer, Lomont::MpmcRingBuffer)
+// items are interleaved across threads, so check a checksum instead of
+// order; a full/empty ring yields, so this is also valid on one cpu
+// return true on matches
+template <size_t N, typename RingType>
+bool ThroughputMulti(long size, int producers, int consumers) {
+#ifndef SAMD21_BUILD
+  StopWatch sw;
+  char testName[32];
+  snprintf(testName, sizeof(testName), "Multi%dx%d", producers, consumers);
+  // every thread moves the same count
+  const long perProducer = size / (producers * consumers) * consumers;
+  const long perConsumer = size / (producers * consumers) * producers;
+  Stats stats(testName, RING_NAME(), N, 1, perProducer * producers);
+
+  char buffer[1024];
+  Rand32 rnd;
+  rnd.seed = 0x12345;
+  for (auto i = 0U; i < sizeof(buffer); ++i)
+    buffer[i] = rnd.Next();
+
+  for (int pass = 0; pass < stats.passCount; ++pass) {
+    RingType rb;
+    std::atomic<uint64_t> sent{0}, received{0};
+    std::vector<std::thread> threads;
+
+    sw.Reset();
+    sw.Start();
+
+    for (int p = 0; p < producers; ++p)
+      threads.emplace_back([&, p]() {
+        uint32_t writer = p * 257;
+        uint64_t sum = 0;
+        for (long i = 0; i < perProducer; ++i) {
+          while (!rb.Put(buffer[writer])) // full
+            std::this_thread::yield();
+          sum += (uint8_t)buffer[writer];
+          writer = (writer + 1) & 1023;
+        }
+        sent += sum;
+      });
+
+    for (int c = 0; c < consumers; ++c)
+      threads.emplace_back([&]() {
+        uint64_t sum = 0;
+        char datum;
+        for (long i = 0; i < perConsumer; ++i) {
+          while (!rb.Get(datum)) // empty
+            std::this_thread::yield();
+          sum += (uint8_t)datum;
+        }
+        received += sum;
+      });
+
+    for (auto &t : threads)
+      t.join();
+
+    sw.Stop();
+    stats.AddPass(sw);
+
+    // every Get matched a Put (counts are fixed), so a lost, duplicated or
+    // torn item shows up in the checksum
+    stats.success &= sent == received && rb.IsEmpty();
+    if (!stats.success)
+      Error("Error: mismatch!");
+  }
+
+  Log(stats);
+  return stats.success;
+#else
+  return true;
+#endif
+}
+
 // simple checks
 // return true on success
 // error msg  and false on error
@@ -534,7 +778,7 @@ template <size_t N> bool FinalStressTest() {
   t2.join();
 
   sw.Stop();
-  stats.Add(sw.ElapsedMs());
+  stats.AddPass(sw);
 
   stats.success = errors1 + errors2 == 0;
   if (!stats.success)
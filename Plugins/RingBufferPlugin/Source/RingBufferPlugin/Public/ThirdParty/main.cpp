@@ -1,4 +1,11 @@
-#if 0
+// Standalone throughput benchmark for the ring buffers in this folder.
+// Built outside the engine by Plugins/RingBufferPlugin/Benchmark, which
+// defines RING_BUFFER_BENCHMARK; Unreal Build Tool compiles every .cpp under
+// the module, so the guard keeps it out of the plugin.
+#ifdef RING_BUFFER_BENCHMARK
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <thread>
@@ -18,6 +25,7 @@
 #include "CacheRingBuffer.h" // move read/write to other locations for cache help
 #include "BlocksRingBuffer.h" // add read/write in blocks
 #include "RingBuffer.h" // add predictive read/write locations to loosen false sharing
+#include "MpmcRingBuffer.h" // per cell sequence numbers, any number of threads
 
 // send output here
 void WriteLine(const char * line);
@@ -341,38 +349,170 @@ void TestTimingBySize()
 	ThroughputSingle<N, M, SimpleRingBuffer <N>>(51'200'000);   // single thread, simple to implement
 }
 
-#ifndef SAMD21_BUILD // ARM board
-int main()
+// every ring variant, SimpleRingBuffer through Lomont::RingBuffer, one item
+// at a time and (where supported) in blocks of M
+template <size_t N, size_t M> void SweepSingle(long bytes)
 {
+	ThroughputSingle<N, M, SimpleRingBuffer <N>>(bytes);
+	ThroughputSingle<N, M, GenericRingBuffer<N>>(bytes);
+	ThroughputSingle<N, M, LockedRingBuffer <N>>(bytes / 5);
+	ThroughputSingle<N, M, AtomicsRingBuffer<N>>(bytes);
+	ThroughputSingle<N, M, ModulusRingBuffer<N, char, uint32_t, SlowRingMod<N, uint32_t>>>(bytes);
+	ThroughputSingle<N, M, ModulusRingBuffer<N, char, uint32_t, MidRingMod<N, uint32_t>>>(bytes);
+	ThroughputSingle<N, M, ModulusRingBuffer<N, char, uint32_t, FastRingMod<N, uint32_t>>>(bytes);
+	ThroughputSingle<N, M, RelaxedRingBuffer<N>>(bytes);
+	ThroughputSingle<N, M, FullRingBuffer   <N>>(bytes);
+	ThroughputSingle<N, M, CacheRingBuffer  <N>>(bytes);
+	ThroughputSingle<N, M, BlocksRingBuffer <N>>(bytes);
+	ThroughputSingle<N, M, RingBuffer       <N>>(bytes);
+	ThroughputSingleBlock<N, M, BlocksRingBuffer <N>>(bytes);
+	ThroughputSingleBlock<N, M, RingBuffer       <N>>(bytes);
+	if constexpr (is_power_of_two<N>::value)
+		ThroughputSingle<N, M, MpmcRingBuffer<N>>(bytes);
+}
 
-	//todo - 
-	//	TODO  can possibly change to not use 2 mod per loop  mod in array w + i, then out of loop mod2n final w + n  errors  why ? Possibly can split into values that stay in bounds, and do those  remove all per loop mod
+// the thread safe variants, producer and consumer on their own threads
+template <size_t N, size_t M> void SweepDouble(long bytes)
+{
+	ThroughputDouble<N, M, LockedRingBuffer <N>>(bytes / 50);
+	ThroughputDouble<N, M, AtomicsRingBuffer<N>>(bytes);
+	ThroughputDouble<N, M, ModulusRingBuffer<N, char, uint32_t, SlowRingMod<N, uint32_t>>>(bytes);
+	ThroughputDouble<N, M, ModulusRingBuffer<N, char, uint32_t, MidRingMod<N, uint32_t>>>(bytes);
+	ThroughputDouble<N, M, ModulusRingBuffer<N, char, uint32_t, FastRingMod<N, uint32_t>>>(bytes);
+	ThroughputDouble<N, M, RelaxedRingBuffer<N>>(bytes);
+	ThroughputDouble<N, M, FullRingBuffer   <N>>(bytes);
+	ThroughputDouble<N, M, CacheRingBuffer  <N>>(bytes);
+	ThroughputDouble<N, M, BlocksRingBuffer <N>>(bytes);
+	ThroughputDouble<N, M, RingBuffer       <N>>(bytes);
+	ThroughputDoubleBlock<N, M, BlocksRingBuffer <N>>(bytes);
+	ThroughputDoubleBlock<N, M, RingBuffer       <N>>(bytes);
+	if constexpr (is_power_of_two<N>::value)
+		ThroughputDouble<N, M, MpmcRingBuffer<N>>(bytes);
+}
 
+// MPMC: the lock free ring against the mutex one, fan-in, fan-out and both;
+// both rings move the same bytes so their rows compare like for like
+template <size_t N> void SweepMulti(long bytes)
+{
+	static const int threads[][2] = { {1, 1}, {2, 2}, {4, 1}, {1, 4}, {4, 4} };
+	for (const auto & pc : threads)
+	{
+		ThroughputMulti<N, LockedRingBuffer<N>>(bytes, pc[0], pc[1]);
+		ThroughputMulti<N, MpmcRingBuffer  <N>>(bytes, pc[0], pc[1]);
+	}
+}
 
+// ring sizes (power of 2 and not) x block sizes; blocks stay <= N/2 so the
+// single threaded put-M-then-get-M loop never overfills a ring
+template <typename Sweep> void SweepSizes(long bytes)
+{
+	Sweep::template Run<32,   1>(bytes);
+	Sweep::template Run<32,  16>(bytes);
+	Sweep::template Run<127, 16>(bytes);
+	Sweep::template Run<128,  1>(bytes);
+	Sweep::template Run<128, 16>(bytes);
+	Sweep::template Run<128, 64>(bytes);
+	Sweep::template Run<1024, 1>(bytes);
+	Sweep::template Run<1024, 16>(bytes);
+	Sweep::template Run<1024, 64>(bytes);
+}
 
-	//FinalStressTest<126>();
+struct SingleSweep { template <size_t N, size_t M> static void Run(long bytes) { SweepSingle<N, M>(bytes); } };
+struct DoubleSweep { template <size_t N, size_t M> static void Run(long bytes) { SweepDouble<N, M>(bytes); } };
 
-    //extern void TestRelacy();
-	//TestRelacy(); // do relacy thread checker testing
-	//TestSanity(1000); // sanity check a buffer
+void Sweep(long bytes, int producerCpu, int consumerCpu)
+{
+	SweepSizes<SingleSweep>(bytes);
+
+	// unpinned; yields when full/empty, so it runs (slowly) on one cpu too
+	Config().producerCpu = Config().consumerCpu = -1;
+	SweepMulti<128>(bytes);
+	SweepMulti<1024>(bytes);
+
+	// the double tests spin-wait on each other, which only measures the
+	// scheduler on a single cpu
+	if (std::thread::hardware_concurrency() < 2)
+	{
+		cerr << "one cpu: skipping the two thread tests" << endl;
+		return;
+	}
+
+	// unpinned, then pinned to the requested cpus
+	Config().producerCpu = Config().consumerCpu = -1;
+	SweepSizes<DoubleSweep>(bytes);
+	if (producerCpu >= 0 && consumerCpu >= 0)
+	{
+		Config().producerCpu = producerCpu;
+		Config().consumerCpu = consumerCpu;
+		SweepSizes<DoubleSweep>(bytes);
+		Config().producerCpu = Config().consumerCpu = -1;
+	}
+}
+
+static const char * ArgValue(const char * arg, const char * name)
+{
+	const size_t length = strlen(name);
+	return strncmp(arg, name, length) == 0 ? arg + length : nullptr;
+}
+
+#ifndef SAMD21_BUILD // ARM board
+// ring_benchmark [--format=csv|json|text] [--passes=20] [--bytes=1000000]
+//                [--cpus=P,C | --no-pin] [--quick] [--slides]
+//   default  sweep every ring x size x block x pinning, then MPMC thread
+//            counts, csv on stdout
+//   --cpus   producer,consumer cpus for the pinned pass (default 0,1)
+//   --quick  2 passes of small transfers, a smoke test for ctest
+//   --slides the original Performance VI run from the talk
+int main(int argc, char ** argv)
+{
+	long bytes = 1'000'000;
+	bool slides = false;
+	int producerCpu = 0, consumerCpu = 1;
+	Config().format = "csv";
+	Config().passCount = 20;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char * value = nullptr;
+		if ((value = ArgValue(argv[i], "--format=")) != nullptr)
+			Config().format = value;
+		else if ((value = ArgValue(argv[i], "--passes=")) != nullptr)
+			Config().passCount = atoi(value) > 0 ? atoi(value) : 1;
+		else if ((value = ArgValue(argv[i], "--bytes=")) != nullptr)
+			bytes = atol(value) > 0 ? atol(value) : 1;
+		else if ((value = ArgValue(argv[i], "--cpus=")) != nullptr)
+		{
+			if (sscanf(value, "%d,%d", &producerCpu, &consumerCpu) != 2)
+				producerCpu = consumerCpu = -1;
+		}
+		else if (strcmp(argv[i], "--no-pin") == 0)
+			producerCpu = consumerCpu = -1;
+		else if (strcmp(argv[i], "--quick") == 0)
+		{
+			Config().passCount = 2;
+			bytes = 20'000;
+		}
+		else if (strcmp(argv[i], "--slides") == 0)
+			slides = true;
+		else
+		{
+			cerr << "unknown argument " << argv[i] << endl;
+			return 2;
+		}
+	}
+
+	if (slides)
+	{
+		Config().format = "text";
+		Config().passCount = 100;
+		ShowLogFormat();
+		PerformanceVI(3'000'000);
+		return 0;
+	}
 
 	ShowLogFormat();
-	
-	// determined that avg ms should be 25-50 to get good samples
-	// also fix sizes we test, say 256,16 in general
-	// TestTimingBySize(); 
-
-	//TestAllSingle();  // each through single threaded
-	//TestAllDouble();  // each through single threaded
-
-	// particular tests for talk slides
-	int bytes = 3'000'000;
-	//PerformanceI(bytes);
-	//PerformanceII(bytes);
-	//PerformanceIII(bytes);
-	//PerformanceIV(bytes);
-	//PerformanceV(bytes);
-	PerformanceVI(bytes);
+	Sweep(bytes, producerCpu, consumerCpu);
+	EndLogFormat();
 	return 0;
 }
 #endif               // SAMD21_BUILD